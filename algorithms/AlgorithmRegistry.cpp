@@ -0,0 +1,14 @@
+#include "AlgorithmRegistry.h"
+#include "AndrewsAlgorithm.h"
+#include "AutoHull.h"
+#include "GrahamScan.h"
+
+const std::vector<AlgorithmInfo>& AlgorithmRegistry::algorithms()
+{
+    static const std::vector<AlgorithmInfo> registry = {
+        {"Andrew (Monotone Chain)", []() { return std::make_unique<AndrewsAlgorithm>(); }},
+        {"Graham Scan", []() { return std::make_unique<GrahamScan>(); }},
+        {"Auto (sampled)", []() { return std::make_unique<AutoHull>(); }}
+    };
+    return registry;
+}
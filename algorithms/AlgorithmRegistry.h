@@ -0,0 +1,24 @@
+#ifndef ALGORITHMREGISTRY_H
+#define ALGORITHMREGISTRY_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "ConvexHullAlgorithm.h"
+
+struct AlgorithmInfo
+{
+    QString name;
+    std::function<std::unique_ptr<ConvexHullAlgorithm>()> create;
+};
+
+// Every ConvexHullAlgorithm that tools such as the comparison runner should
+// know about. New algorithms register themselves here.
+class AlgorithmRegistry
+{
+public:
+    static const std::vector<AlgorithmInfo>& algorithms();
+};
+
+#endif // ALGORITHMREGISTRY_H
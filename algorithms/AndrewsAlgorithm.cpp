@@ -1,64 +1,74 @@
 #include "AndrewsAlgorithm.h"
+#include "MonotoneChain.h"
 #include "../geometry/Orientation.h"
 
 #include <algorithm>
 #include <vector>
 
-std::vector<Point>
-AndrewsAlgorithm::computeHull(const std::vector<Point>& points)
+namespace {
+
+template<typename T>
+void monotoneChain(const std::vector<BasicPoint<T>>& points,
+                   HullScratch<T>& scratch,
+                   std::vector<BasicPoint<T>>& hull)
 {
-    if (points.size() < 3) {
-        return points;
+    if (points.empty()) {
+        hull.clear();
+        return;
     }
 
-    std::vector<Point> pts = points;
-
-    std::sort(pts.begin(), pts.end(), [](const Point& a, const Point& b) {
-        if (a.x == b.x) {
-            return a.y < b.y;
-        }
-        return a.x < b.x;
+    std::vector<BasicPoint<T>>& pts = scratch.sorted;
+    pts.assign(points.begin(), points.end());
+    std::sort(pts.begin(), pts.end(), [](const BasicPoint<T>& a, const BasicPoint<T>& b) {
+        return lexicographicLess(a, b);
     });
 
-    std::vector<Point> lower;
-
-    for (const Point& p : pts) {
-        while (lower.size() >= 2) {
-            const Point& p1 = lower[lower.size() - 2];
-            const Point& p2 = lower[lower.size() - 1];
-
-            if (orientation(p1, p2, p) == Orientation::CounterClockWise) {
-                break;
-            }
-
-            lower.pop_back();
-        }
-        lower.push_back(p);
+    std::vector<BasicPoint<T>>& chain = scratch.chain;
+    if (chain.size() < 2 * pts.size()) {
+        chain.resize(2 * pts.size());
     }
 
-    std::vector<Point> upper;
-    for (int i = static_cast<int>(pts.size()) - 1; i >= 0; --i) {
-        const Point& p = pts[i];
+    const std::size_t count = monotoneChainSorted(pts.data(), pts.size(), chain.data());
+    hull.assign(chain.begin(), chain.begin() + count);
+}
 
-        while (upper.size() >= 2) {
-            const Point& p1 = upper[upper.size() - 2];
-            const Point& p2 = upper[upper.size() - 1];
+} // namespace
 
-            if (orientation(p1, p2, p) == Orientation::CounterClockWise) {
-                break;
-            }
+std::vector<Point>
+AndrewsAlgorithm::computeHull(const std::vector<Point>& points)
+{
+    std::vector<Point> hull;
+    computeHullInto(points, hull);
+    return hull;
+}
 
-            upper.pop_back();
-        }
-        upper.push_back(p);
-    }
+std::vector<PointI>
+AndrewsAlgorithm::computeHull(const std::vector<PointI>& points)
+{
+    std::vector<PointI> hull;
+    computeHullInto(points, hull);
+    return hull;
+}
 
-    lower.pop_back();
-    upper.pop_back();
+void AndrewsAlgorithm::computeHullInto(const std::vector<Point>& points, std::vector<Point>& hull)
+{
+    monotoneChain(points, m_scratch, hull);
+}
 
-    lower.insert(lower.end(), upper.begin(), upper.end());
+void AndrewsAlgorithm::computeHullInto(const std::vector<PointI>& points, std::vector<PointI>& hull)
+{
+    monotoneChain(points, m_scratchI, hull);
+}
 
-    return lower;
+std::size_t AndrewsAlgorithm::scratchBytes() const
+{
+    return m_scratch.bytes() + m_scratchI.bytes();
+}
+
+void AndrewsAlgorithm::releaseScratch()
+{
+    m_scratch.release();
+    m_scratchI.release();
 }
 
 std::vector<AnimationStep>
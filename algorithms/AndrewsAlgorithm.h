@@ -2,6 +2,7 @@
 #define ANDREWSALGORITHM_H
 
 #include "ConvexHullAlgorithm.h"
+#include "HullScratch.h"
 
 class AndrewsAlgorithm : public ConvexHullAlgorithm
 {
@@ -10,11 +11,20 @@ public:
     ~AndrewsAlgorithm() override = default;
 
     std::vector<Point> computeHull(const std::vector<Point>& points) override;
+    std::vector<PointI> computeHull(const std::vector<PointI>& points) override;
+    void computeHullInto(const std::vector<Point>& points, std::vector<Point>& hull) override;
+    void computeHullInto(const std::vector<PointI>& points, std::vector<PointI>& hull) override;
+    std::size_t scratchBytes() const override;
+    void releaseScratch() override;
     std::vector<AnimationStep> generateSteps(const std::vector<Point>& points) override;
     QString name() const override;
 
 private:
     std::vector<Point> buildHalf(const std::vector<Point>& points);
+
+private:
+    HullScratch<double> m_scratch;
+    HullScratch<std::int32_t> m_scratchI;
 };
 
 #endif // ANDREWSALGORITHM_H
@@ -0,0 +1,250 @@
+#include "ApproximateHull.h"
+#include "MonotoneChain.h"
+#include "../core/Parallel.h"
+#include "../geometry/Orientation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr std::size_t ChunkSize = 1 << 16;
+// Points per inner block: small enough to stay in L1 while every direction
+// sweeps over it.
+constexpr std::size_t BlockSize = 512;
+
+constexpr double Pi = 3.14159265358979323846;
+
+// Updates the extremes of one block. The first pass keeps a running maximum
+// and minimum per direction with the directions as the inner loop, which the
+// compiler turns into packed multiply and blend instructions. The point
+// attaining a new extreme is searched for separately; after the first few
+// blocks that is rare.
+void scanBlock(const Point* points, std::size_t count,
+               const double* ux, const double* uy, int half,
+               double* high, double* low,
+               double* support, Point* extremes)
+{
+    for (int j = 0; j < half; ++j) {
+        high[j] = -std::numeric_limits<double>::infinity();
+        low[j] = std::numeric_limits<double>::infinity();
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const double px = points[i].x;
+        const double py = points[i].y;
+        for (int j = 0; j < half; ++j) {
+            const double d = ux[j] * px + uy[j] * py;
+            high[j] = d > high[j] ? d : high[j];
+            low[j] = d < low[j] ? d : low[j];
+        }
+    }
+
+    for (int j = 0; j < half; ++j) {
+        const double x = ux[j];
+        const double y = uy[j];
+
+        // Rescanned rather than matched against high/low, so a differently
+        // contracted multiply-add in the packed loop cannot lose the point.
+        if (high[j] > support[j]) {
+            std::size_t best = 0;
+            double bestValue = x * points[0].x + y * points[0].y;
+            for (std::size_t i = 1; i < count; ++i) {
+                const double d = x * points[i].x + y * points[i].y;
+                if (d > bestValue) {
+                    bestValue = d;
+                    best = i;
+                }
+            }
+            if (bestValue > support[j]) {
+                support[j] = bestValue;
+                extremes[j] = points[best];
+            }
+        }
+
+        if (-low[j] > support[j + half]) {
+            std::size_t best = 0;
+            double bestValue = x * points[0].x + y * points[0].y;
+            for (std::size_t i = 1; i < count; ++i) {
+                const double d = x * points[i].x + y * points[i].y;
+                if (d < bestValue) {
+                    bestValue = d;
+                    best = i;
+                }
+            }
+            if (-bestValue > support[j + half]) {
+                support[j + half] = -bestValue;
+                extremes[j + half] = points[best];
+            }
+        }
+    }
+}
+
+double distanceToSegment(const Point& p, const Point& a, const Point& b)
+{
+    const double dx = b.x - a.x;
+    const double dy = b.y - a.y;
+    const double lengthSquared = dx * dx + dy * dy;
+    double t = lengthSquared > 0.0 ? ((p.x - a.x) * dx + (p.y - a.y) * dy) / lengthSquared : 0.0;
+    t = std::clamp(t, 0.0, 1.0);
+    return std::hypot(p.x - (a.x + t * dx), p.y - (a.y + t * dy));
+}
+
+} // namespace
+
+ApproximateHull::ApproximateHull(int directions)
+{
+    // An even count lets each direction share its dot product with the
+    // opposite one.
+    directions = std::max(directions + (directions & 1), 8);
+    const int half = directions / 2;
+
+    for (int j = 0; j < half; ++j) {
+        const double angle = 2.0 * Pi * j / directions;
+        m_ux.push_back(std::cos(angle));
+        m_uy.push_back(std::sin(angle));
+    }
+}
+
+int ApproximateHull::directions() const
+{
+    return static_cast<int>(2 * m_ux.size());
+}
+
+void ApproximateHull::compute(const std::vector<Point>& points, std::vector<Point>& hull)
+{
+    const int half = static_cast<int>(m_ux.size());
+    const int k = 2 * half;
+
+    m_polygon.clear();
+    m_errorBound = 0.0;
+    m_insideTolerance = 0.0;
+
+    if (points.empty()) {
+        hull.clear();
+        return;
+    }
+
+    // One row of extremes per chunk, merged afterwards, so the pass needs no
+    // synchronization.
+    const std::size_t chunkCount = (points.size() + ChunkSize - 1) / ChunkSize;
+    std::vector<double> chunkSupport(chunkCount * k, -std::numeric_limits<double>::infinity());
+    std::vector<Point> chunkExtremes(chunkCount * k);
+
+    parallelFor(0, points.size(), ChunkSize, [&](std::size_t begin, std::size_t end) {
+        const std::size_t chunk = begin / ChunkSize;
+        double* support = chunkSupport.data() + chunk * k;
+        Point* extremes = chunkExtremes.data() + chunk * k;
+        std::vector<double> high(half);
+        std::vector<double> low(half);
+
+        for (std::size_t block = begin; block < end; block += BlockSize) {
+            scanBlock(points.data() + block, std::min(BlockSize, end - block),
+                      m_ux.data(), m_uy.data(), half,
+                      high.data(), low.data(), support, extremes);
+        }
+    });
+
+    m_support.assign(chunkSupport.begin(), chunkSupport.begin() + k);
+    m_extremes.assign(chunkExtremes.begin(), chunkExtremes.begin() + k);
+    for (std::size_t chunk = 1; chunk < chunkCount; ++chunk) {
+        for (int j = 0; j < k; ++j) {
+            if (chunkSupport[chunk * k + j] > m_support[j]) {
+                m_support[j] = chunkSupport[chunk * k + j];
+                m_extremes[j] = chunkExtremes[chunk * k + j];
+            }
+        }
+    }
+
+    // The extremes are already in counter-clockwise order, but repeats and
+    // collinear runs are easiest to drop with the regular chain.
+    std::vector<Point> sorted = m_extremes;
+    std::sort(sorted.begin(), sorted.end(), [](const Point& a, const Point& b) {
+        return lexicographicLess(a, b);
+    });
+    m_polygon.resize(2 * sorted.size());
+    m_polygon.resize(monotoneChainSorted(sorted.data(), sorted.size(), m_polygon.data()));
+    hull.assign(m_polygon.begin(), m_polygon.end());
+
+    for (int i = 0; i < k; ++i) {
+        const int j = (i + 1) % k;
+        const Point& a = m_extremes[i];
+        const Point& b = m_extremes[j];
+        if (a.x == b.x && a.y == b.y) {
+            continue;
+        }
+
+        const double ax = i < half ? m_ux[i] : -m_ux[i - half];
+        const double ay = i < half ? m_uy[i] : -m_uy[i - half];
+        const double bx = j < half ? m_ux[j] : -m_ux[j - half];
+        const double by = j < half ? m_uy[j] : -m_uy[j - half];
+        const double determinant = ax * by - ay * bx;
+
+        const Point apex((m_support[i] * by - m_support[j] * ay) / determinant,
+                         (ax * m_support[j] - bx * m_support[i]) / determinant);
+        m_errorBound = std::max(m_errorBound, distanceToSegment(apex, a, b));
+    }
+
+    double extent = 0.0;
+    for (const Point& v : m_polygon) {
+        extent = std::max({extent, std::abs(v.x), std::abs(v.y)});
+    }
+    m_insideTolerance = 1e-12 * extent * extent;
+}
+
+double ApproximateHull::errorBound() const
+{
+    return m_errorBound;
+}
+
+void ApproximateHull::collectCandidates(const std::vector<Point>& points, std::vector<Point>& candidates) const
+{
+    const std::size_t chunkCount = (points.size() + ChunkSize - 1) / ChunkSize;
+    std::vector<std::vector<Point>> chunkCandidates(chunkCount);
+
+    parallelFor(0, points.size(), ChunkSize, [&](std::size_t begin, std::size_t end) {
+        std::vector<Point>& out = chunkCandidates[begin / ChunkSize];
+        for (std::size_t i = begin; i < end; ++i) {
+            if (!isStrictlyInside(points[i])) {
+                out.push_back(points[i]);
+            }
+        }
+    });
+
+    candidates.clear();
+    for (const std::vector<Point>& chunk : chunkCandidates) {
+        candidates.insert(candidates.end(), chunk.begin(), chunk.end());
+    }
+}
+
+// Binary search over the fan of triangles around the first vertex. Points
+// within rounding distance of an edge count as outside, so no exact hull
+// vertex is ever filtered away.
+bool ApproximateHull::isStrictlyInside(const Point& p) const
+{
+    const std::size_t h = m_polygon.size();
+    if (h < 3) {
+        return false;
+    }
+
+    const Point& origin = m_polygon[0];
+    if (cross(origin, m_polygon[1], p) <= m_insideTolerance ||
+        cross(m_polygon[h - 1], origin, p) <= m_insideTolerance)
+    {
+        return false;
+    }
+
+    std::size_t low = 1;
+    std::size_t high = h - 1;
+    while (high - low > 1) {
+        const std::size_t middle = (low + high) / 2;
+        if (cross(origin, m_polygon[middle], p) > 0) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+
+    return cross(m_polygon[low], m_polygon[low + 1], p) > m_insideTolerance;
+}
@@ -0,0 +1,50 @@
+#ifndef APPROXIMATEHULL_H
+#define APPROXIMATEHULL_H
+
+#include <cstddef>
+#include <vector>
+
+#include "../geometry/Point.h"
+
+// Inner approximation of the hull from the extreme points in K evenly spaced
+// directions, found in one streaming pass over the input. The result is a
+// convex polygon with input points as vertices, so it lies inside the exact
+// hull. Every exact hull point within the wedge between two adjacent
+// directions lies in the triangle spanned by their extreme points and the
+// intersection of their support lines. errorBound() is the largest of those
+// triangle heights, an upper bound on the Hausdorff distance to the exact
+// hull. A priori it is at most diameter * tan(pi / K) / 2.
+class ApproximateHull
+{
+public:
+    static constexpr int DefaultDirections = 64;
+
+    explicit ApproximateHull(int directions = DefaultDirections);
+
+    int directions() const;
+
+    // Counter-clockwise, starting at the lexicographically smallest vertex.
+    void compute(const std::vector<Point>& points, std::vector<Point>& hull);
+    double errorBound() const;
+
+    // Copies the points that are not strictly inside the last computed
+    // polygon. The exact hull of the candidates equals that of all points.
+    void collectCandidates(const std::vector<Point>& points, std::vector<Point>& candidates) const;
+
+private:
+    bool isStrictlyInside(const Point& p) const;
+
+private:
+    // Unit vectors for the first half of the directions; the second half are
+    // their negations and share the dot products.
+    std::vector<double> m_ux;
+    std::vector<double> m_uy;
+
+    std::vector<double> m_support;
+    std::vector<Point> m_extremes;
+    std::vector<Point> m_polygon;
+    double m_errorBound = 0.0;
+    double m_insideTolerance = 0.0;
+};
+
+#endif // APPROXIMATEHULL_H
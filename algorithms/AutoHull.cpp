@@ -0,0 +1,364 @@
+#include "AutoHull.h"
+#include "MonotoneChain.h"
+#include "../core/Parallel.h"
+
+#include <QLoggingCategory>
+
+#include <algorithm>
+#include <cmath>
+
+Q_LOGGING_CATEGORY(lcAutoHull, "convexhull.auto", QtWarningMsg)
+
+namespace {
+
+// Below this the profile costs more than any strategy can save.
+constexpr std::size_t MinProfiledCount = 4096;
+constexpr std::size_t SampleSize = 1024;
+constexpr double FilterHullFraction = 0.1;
+constexpr double DedupRatio = 0.3;
+constexpr std::size_t FilterChunkSize = 1 << 16;
+
+// Estimated share of repeats among n points spread evenly over `cells`
+// distinct positions: n minus the expected number of occupied cells.
+double gridDuplicateRatio(double cells, double n)
+{
+    if (cells <= 0.0 || n <= 0.0) {
+        return 0.0;
+    }
+    return std::max(0.0, 1.0 - cells * -std::expm1(-n / cells) / n);
+}
+
+// Stops at the first pair out of order, so unsorted input costs little.
+template<typename T>
+bool isSorted(const std::vector<BasicPoint<T>>& points, bool descending)
+{
+    for (std::size_t i = 1; i < points.size(); ++i) {
+        const bool outOfOrder = descending ? lexicographicLess(points[i - 1], points[i])
+                                           : lexicographicLess(points[i], points[i - 1]);
+        if (outOfOrder) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename T>
+double cellCount(T minX, T maxX, T minY, T maxY);
+
+template<>
+double cellCount<std::int32_t>(std::int32_t minX, std::int32_t maxX, std::int32_t minY, std::int32_t maxY)
+{
+    return (static_cast<double>(maxX) - minX + 1.0) * (static_cast<double>(maxY) - minY + 1.0);
+}
+
+// Doubles have no grid to count.
+template<>
+double cellCount<double>(double, double, double, double)
+{
+    return 0.0;
+}
+
+} // namespace
+
+std::vector<Point> AutoHull::computeHull(const std::vector<Point>& points)
+{
+    std::vector<Point> hull;
+    computeHullInto(points, hull);
+    return hull;
+}
+
+std::vector<PointI> AutoHull::computeHull(const std::vector<PointI>& points)
+{
+    std::vector<PointI> hull;
+    computeHullInto(points, hull);
+    return hull;
+}
+
+void AutoHull::computeHullInto(const std::vector<Point>& points, std::vector<Point>& hull)
+{
+    compute(points, hull, m_scratch);
+}
+
+void AutoHull::computeHullInto(const std::vector<PointI>& points, std::vector<PointI>& hull)
+{
+    compute(points, hull, m_scratchI);
+}
+
+std::size_t AutoHull::scratchBytes() const
+{
+    std::size_t bytes = m_andrew.scratchBytes() + m_deduplicator.scratchBytes() + m_scratch.bytes() + m_scratchI.bytes();
+    for (const std::vector<PointI>& part : m_parts) {
+        bytes += part.capacity() * sizeof(PointI);
+    }
+    return bytes;
+}
+
+void AutoHull::releaseScratch()
+{
+    m_andrew.releaseScratch();
+    m_deduplicator.releaseScratch();
+    m_scratch.release();
+    m_scratchI.release();
+    std::vector<std::vector<PointI>>().swap(m_parts);
+}
+
+std::vector<AnimationStep> AutoHull::generateSteps(const std::vector<Point>& points)
+{
+    return m_andrew.generateSteps(points);
+}
+
+QString AutoHull::name() const
+{
+    return "Auto (sampled)";
+}
+
+const AutoHull::Decision& AutoHull::lastDecision() const
+{
+    return m_decision;
+}
+
+const char* AutoHull::strategyName(Strategy strategy)
+{
+    switch (strategy) {
+    case Strategy::Presorted:
+        return "presorted chain";
+    case Strategy::Filtered:
+        return "octagon filter";
+    case Strategy::Deduplicated:
+        return "dedup";
+    case Strategy::Sorted:
+        break;
+    }
+    return "sort";
+}
+
+QString AutoHull::describe(const Decision& decision)
+{
+    const Profile& profile = decision.profile;
+    if (profile.sampleSize == 0) {
+        return QString("%1 for %2 points (small input, not profiled)")
+            .arg(strategyName(decision.strategy))
+            .arg(static_cast<unsigned long long>(profile.count));
+    }
+    return QString("%1 for %2 points (sorted %3%/%4%, sample hull %5%, duplicates ~%6%, %7 sorted)")
+        .arg(strategyName(decision.strategy))
+        .arg(static_cast<unsigned long long>(profile.count))
+        .arg(profile.ascending * 100.0, 0, 'f', 1)
+        .arg(profile.descending * 100.0, 0, 'f', 1)
+        .arg(profile.sampleHullFraction * 100.0, 0, 'f', 1)
+        .arg(profile.duplicateRatio * 100.0, 0, 'f', 1)
+        .arg(static_cast<unsigned long long>(decision.sortedCount));
+}
+
+void AutoHull::log() const
+{
+    qCInfo(lcAutoHull).noquote() << describe(m_decision);
+}
+
+template<typename T>
+AutoHull::Profile AutoHull::profile(const std::vector<BasicPoint<T>>& points, HullScratch<T>& scratch)
+{
+    Profile result;
+    const std::size_t n = points.size();
+    result.count = n;
+
+    // Evenly strided, so clustered or ordered inputs are sampled throughout.
+    // Each sampled point is also compared with its successor to see how
+    // sorted the input is.
+    std::vector<BasicPoint<T>>& sample = scratch.sorted;
+    const std::size_t sampleSize = std::min(n, SampleSize);
+    sample.resize(sampleSize);
+    std::size_t pairs = 0;
+    std::size_t ascending = 0;
+    std::size_t descending = 0;
+    for (std::size_t i = 0; i < sampleSize; ++i) {
+        const std::size_t index = i * n / sampleSize;
+        sample[i] = points[index];
+        if (index + 1 < n) {
+            ++pairs;
+            ascending += !lexicographicLess(points[index + 1], points[index]);
+            descending += !lexicographicLess(points[index], points[index + 1]);
+        }
+    }
+    result.ascending = static_cast<double>(ascending) / pairs;
+    result.descending = static_cast<double>(descending) / pairs;
+
+    T minX = sample[0].x;
+    T maxX = sample[0].x;
+    T minY = sample[0].y;
+    T maxY = sample[0].y;
+    for (const BasicPoint<T>& q : sample) {
+        minX = std::min(minX, q.x);
+        maxX = std::max(maxX, q.x);
+        minY = std::min(minY, q.y);
+        maxY = std::max(maxY, q.y);
+    }
+
+    std::sort(sample.begin(), sample.end(), [](const BasicPoint<T>& a, const BasicPoint<T>& b) {
+        return lexicographicLess(a, b);
+    });
+    result.sampleSize = sampleSize;
+
+    std::size_t sampleDuplicates = 0;
+    for (std::size_t i = 1; i < sampleSize; ++i) {
+        sampleDuplicates += sample[i].x == sample[i - 1].x && sample[i].y == sample[i - 1].y;
+    }
+
+    if (scratch.chain.size() < 2 * sampleSize) {
+        scratch.chain.resize(2 * sampleSize);
+    }
+    const std::size_t sampleHull = monotoneChainSorted(sample.data(), sampleSize, scratch.chain.data());
+    result.sampleHullFraction = static_cast<double>(sampleHull) / sampleSize;
+
+    // Repeats inside a small sample show dense spots; the grid estimate
+    // catches even spreads over few distinct positions. The sample's
+    // bounding box is a little small, which errs towards more duplicates.
+    result.duplicateRatio = std::max(static_cast<double>(sampleDuplicates) / sampleSize,
+                                     gridDuplicateRatio(cellCount(minX, maxX, minY, maxY), static_cast<double>(n)));
+    return result;
+}
+
+template<typename T>
+void AutoHull::compute(const std::vector<BasicPoint<T>>& points, std::vector<BasicPoint<T>>& hull,
+                       HullScratch<T>& scratch)
+{
+    const std::size_t n = points.size();
+    m_decision = Decision();
+    m_decision.profile.count = n;
+    m_decision.sortedCount = n;
+
+    if (n < MinProfiledCount) {
+        m_andrew.computeHullInto(points, hull);
+        return;
+    }
+
+    m_decision.profile = profile(points, scratch);
+    const Profile& p = m_decision.profile;
+
+    const bool ascending = p.ascending == 1.0 && isSorted(points, false);
+    if (ascending || (p.descending == 1.0 && isSorted(points, true))) {
+        // Descending order is the ascending order of the input turned by 180
+        // degrees, which keeps orientations, so the same chain applies. Its
+        // hull starts at the largest point and is turned to start at the
+        // lowest, like every other path.
+        m_decision.strategy = Strategy::Presorted;
+        m_decision.sortedCount = 0;
+        if (scratch.chain.size() < 2 * n) {
+            scratch.chain.resize(2 * n);
+        }
+        const std::size_t count = monotoneChainSorted(points.data(), n, scratch.chain.data());
+        hull.assign(scratch.chain.begin(), scratch.chain.begin() + count);
+        if (!ascending) {
+            const auto lowest = std::min_element(hull.begin(), hull.end(),
+                                                 [](const BasicPoint<T>& a, const BasicPoint<T>& b) {
+                                                     return lexicographicLess(a, b);
+                                                 });
+            std::rotate(hull.begin(), lowest, hull.end());
+        }
+    } else if (p.sampleHullFraction <= FilterHullFraction && filterInterior(points, scratch.sorted)) {
+        m_decision.strategy = Strategy::Filtered;
+        m_decision.sortedCount = scratch.sorted.size();
+        m_andrew.computeHullInto(scratch.sorted, hull);
+    } else if (p.duplicateRatio >= DedupRatio) {
+        m_decision.strategy = Strategy::Deduplicated;
+        m_decision.sortedCount = n - m_deduplicator.run(points, scratch.sorted);
+        m_andrew.computeHullInto(scratch.sorted, hull);
+    } else {
+        m_andrew.computeHullInto(points, hull);
+    }
+
+    log();
+}
+
+// The double predicates are not exact; a point just outside an octagon edge
+// could test as inside and be lost from the hull.
+bool AutoHull::filterInterior(const std::vector<Point>&, std::vector<Point>&)
+{
+    return false;
+}
+
+// Akl-Toussaint: the extremes in the eight directions are hull vertices, so
+// nothing strictly inside their polygon can be one. Integer predicates keep
+// the test exact.
+bool AutoHull::filterInterior(const std::vector<PointI>& points, std::vector<PointI>& survivors)
+{
+    const std::size_t n = points.size();
+
+    // Counter-clockwise by direction: -y, x-y, x, x+y, y, y-x, -x, -x-y.
+    std::size_t extreme[8] = {};
+    std::int64_t best[8];
+    auto score = [](const PointI& p, int direction) -> std::int64_t {
+        const std::int64_t x = p.x;
+        const std::int64_t y = p.y;
+        switch (direction) {
+        case 0: return -y;
+        case 1: return x - y;
+        case 2: return x;
+        case 3: return x + y;
+        case 4: return y;
+        case 5: return y - x;
+        case 6: return -x;
+        default: return -x - y;
+        }
+    };
+    for (int d = 0; d < 8; ++d) {
+        best[d] = score(points[0], d);
+    }
+    for (std::size_t i = 1; i < n; ++i) {
+        for (int d = 0; d < 8; ++d) {
+            const std::int64_t s = score(points[i], d);
+            if (s > best[d]) {
+                best[d] = s;
+                extreme[d] = i;
+            }
+        }
+    }
+
+    PointI polygon[8];
+    int corners = 0;
+    for (int d = 0; d < 8; ++d) {
+        const PointI& p = points[extreme[d]];
+        if (corners == 0 || polygon[corners - 1].x != p.x || polygon[corners - 1].y != p.y) {
+            polygon[corners++] = p;
+        }
+    }
+    while (corners > 1 && polygon[corners - 1].x == polygon[0].x && polygon[corners - 1].y == polygon[0].y) {
+        --corners;
+    }
+    // Without area nothing is strictly inside.
+    bool hasArea = false;
+    for (int c = 1; c + 1 < corners && !hasArea; ++c) {
+        hasArea = cross(polygon[0], polygon[c], polygon[c + 1]) != 0;
+    }
+    if (!hasArea) {
+        return false;
+    }
+
+    const std::size_t chunkCount = (n + FilterChunkSize - 1) / FilterChunkSize;
+    if (m_parts.size() < chunkCount) {
+        m_parts.resize(chunkCount);
+    }
+    parallelFor(0, chunkCount, 1, [&](std::size_t firstChunk, std::size_t lastChunk) {
+        for (std::size_t chunk = firstChunk; chunk < lastChunk; ++chunk) {
+            std::vector<PointI>& part = m_parts[chunk];
+            part.clear();
+            const std::size_t end = std::min(n, (chunk + 1) * FilterChunkSize);
+            for (std::size_t i = chunk * FilterChunkSize; i < end; ++i) {
+                const PointI& p = points[i];
+                bool inside = true;
+                for (int c = 0; c < corners && inside; ++c) {
+                    inside = cross(polygon[c], polygon[(c + 1) % corners], p) > 0;
+                }
+                if (!inside) {
+                    part.push_back(p);
+                }
+            }
+        }
+    });
+
+    survivors.clear();
+    for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        survivors.insert(survivors.end(), m_parts[chunk].begin(), m_parts[chunk].end());
+    }
+    return true;
+}
@@ -0,0 +1,97 @@
+#ifndef AUTOHULL_H
+#define AUTOHULL_H
+
+#include "AndrewsAlgorithm.h"
+#include "ConvexHullAlgorithm.h"
+#include "HullScratch.h"
+#include "PointDeduplicator.h"
+
+// Picks a strategy per input instead of making the caller choose. An evenly
+// strided sample of about a thousand points estimates how sorted the input
+// is, the share of points on the hull and the duplicate ratio. Then, in this
+// order:
+//
+//   Presorted     input sorted up or down, confirmed by a full pass: the
+//                 monotone chain runs on it directly, without a copy or a
+//                 sort
+//   Filtered      integer input whose sample hull is small: points strictly
+//                 inside the octagon of the eight axis and diagonal extremes
+//                 are dropped in parallel, the rest is sorted
+//   Deduplicated  many repeated points: PointDeduplicator runs first
+//   Sorted        everything else, plain Andrew
+//
+// Graham's scan is never chosen; it is not faster than Andrew on any input
+// the benchmark covers. Decisions are logged to the "convexhull.auto"
+// category at info level, which is off unless enabled with
+// QT_LOGGING_RULES="convexhull.auto.info=true".
+class AutoHull : public ConvexHullAlgorithm
+{
+public:
+    enum class Strategy {
+        Sorted,
+        Presorted,
+        Filtered,
+        Deduplicated
+    };
+
+    // Inputs too small to be worth profiling keep a sampleSize of 0 and no
+    // statistics; only count is set.
+    struct Profile
+    {
+        std::size_t count = 0;
+        std::size_t sampleSize = 0;
+        // Fractions of sampled neighbouring pairs in non-decreasing and
+        // non-increasing lexicographic order.
+        double ascending = 0.0;
+        double descending = 0.0;
+        // Hull vertices of the sample over its size.
+        double sampleHullFraction = 0.0;
+        double duplicateRatio = 0.0;
+    };
+
+    struct Decision
+    {
+        Strategy strategy = Strategy::Sorted;
+        Profile profile;
+        // Points left for the sort after filtering or deduplication.
+        std::size_t sortedCount = 0;
+    };
+
+    AutoHull() = default;
+    ~AutoHull() override = default;
+
+    std::vector<Point> computeHull(const std::vector<Point>& points) override;
+    std::vector<PointI> computeHull(const std::vector<PointI>& points) override;
+    void computeHullInto(const std::vector<Point>& points, std::vector<Point>& hull) override;
+    void computeHullInto(const std::vector<PointI>& points, std::vector<PointI>& hull) override;
+    std::size_t scratchBytes() const override;
+    void releaseScratch() override;
+    // The animation always shows Andrew's algorithm.
+    std::vector<AnimationStep> generateSteps(const std::vector<Point>& points) override;
+    QString name() const override;
+
+    const Decision& lastDecision() const;
+    static const char* strategyName(Strategy strategy);
+    static QString describe(const Decision& decision);
+
+private:
+    template<typename T>
+    void compute(const std::vector<BasicPoint<T>>& points, std::vector<BasicPoint<T>>& hull,
+                 HullScratch<T>& scratch);
+    template<typename T>
+    Profile profile(const std::vector<BasicPoint<T>>& points, HullScratch<T>& scratch);
+    // False if the filter does not apply; `survivors` is then unspecified.
+    bool filterInterior(const std::vector<Point>& points, std::vector<Point>& survivors);
+    bool filterInterior(const std::vector<PointI>& points, std::vector<PointI>& survivors);
+    void log() const;
+
+private:
+    AndrewsAlgorithm m_andrew;
+    PointDeduplicator m_deduplicator;
+    HullScratch<double> m_scratch;
+    HullScratch<std::int32_t> m_scratchI;
+    std::vector<std::vector<PointI>> m_parts;
+    Decision m_decision;
+};
+
+#endif // AUTOHULL_H
@@ -0,0 +1,228 @@
+#include "BatchHull.h"
+#include "MonotoneChain.h"
+#include "../core/Parallel.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+constexpr std::size_t SetsPerTask = 256;
+
+struct Comparator {
+    std::uint8_t a;
+    std::uint8_t b;
+};
+
+constexpr std::size_t MaxComparators = 80;
+
+struct Network {
+    Comparator comparators[MaxComparators];
+    std::size_t size;
+};
+
+// Batcher's odd-even merge sort for 16 wires, truncated to the first n wires.
+// Dropped comparators would only touch wires that carry +infinity padding,
+// which no comparator moves, so the remaining ones still sort n inputs.
+constexpr Network oddEvenMergeNetwork(std::size_t n)
+{
+    Network network{};
+    const std::size_t width = BatchHull::NetworkLimit;
+    for (std::size_t p = 1; p < width; p += p) {
+        for (std::size_t k = p; k > 0; k /= 2) {
+            for (std::size_t j = k % p; j + k < width; j += k + k) {
+                for (std::size_t i = 0; i < k && i + j + k < width; ++i) {
+                    if ((i + j) / (p + p) == (i + j + k) / (p + p) && i + j + k < n) {
+                        network.comparators[network.size++] = {
+                            static_cast<std::uint8_t>(i + j),
+                            static_cast<std::uint8_t>(i + j + k)
+                        };
+                    }
+                }
+            }
+        }
+    }
+    return network;
+}
+
+template<std::size_t N>
+struct NetworkFor {
+    static constexpr Network value = oddEvenMergeNetwork(N);
+};
+
+// Branch-free on purpose: with random input every comparator would be a coin
+// flip for the branch predictor.
+inline void compareExchange(Point& a, Point& b)
+{
+    const bool swap = (b.x < a.x) | ((b.x == a.x) & (b.y < a.y));
+    const double lowX = swap ? b.x : a.x;
+    const double lowY = swap ? b.y : a.y;
+    const double highX = swap ? a.x : b.x;
+    const double highY = swap ? a.y : b.y;
+    a = Point(lowX, lowY);
+    b = Point(highX, highY);
+}
+
+// Integer points are sorted as 64-bit keys whose unsigned order is the
+// lexicographic order of the points, so a comparator is a min and a max.
+inline void compareExchange(std::uint64_t& a, std::uint64_t& b)
+{
+    const std::uint64_t low = std::min(a, b);
+    const std::uint64_t high = std::max(a, b);
+    a = low;
+    b = high;
+}
+
+inline std::uint64_t sortKey(const PointI& p)
+{
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(p.x) ^ 0x80000000u) << 32) |
+           (static_cast<std::uint32_t>(p.y) ^ 0x80000000u);
+}
+
+inline PointI fromSortKey(std::uint64_t key)
+{
+    return PointI(static_cast<std::int32_t>(static_cast<std::uint32_t>(key >> 32) ^ 0x80000000u),
+                  static_cast<std::int32_t>(static_cast<std::uint32_t>(key) ^ 0x80000000u));
+}
+
+// The network is unrolled at compile time so every element index is a
+// constant and the values can stay in registers.
+template<std::size_t N, typename Value, std::size_t... I>
+inline void applyNetwork(Value* values, std::index_sequence<I...>)
+{
+    constexpr const Network& network = NetworkFor<N>::value;
+    static_cast<void>(values);
+    (compareExchange(values[network.comparators[I].a], values[network.comparators[I].b]), ...);
+}
+
+template<std::size_t N>
+void sortFixed(Point* points)
+{
+    applyNetwork<N>(points, std::make_index_sequence<NetworkFor<N>::value.size>());
+}
+
+template<std::size_t N>
+void sortFixed(PointI* points)
+{
+    std::uint64_t keys[N];
+    for (std::size_t i = 0; i < N; ++i) {
+        keys[i] = sortKey(points[i]);
+    }
+    applyNetwork<N>(keys, std::make_index_sequence<NetworkFor<N>::value.size>());
+    for (std::size_t i = 0; i < N; ++i) {
+        points[i] = fromSortKey(keys[i]);
+    }
+}
+
+// Entry i sorts i + 1 points; empty sets never get here, and a zero-length
+// key array would not be valid C++.
+template<typename PointT, std::size_t... N>
+void networkSort(PointT* points, std::size_t n, std::index_sequence<N...>)
+{
+    using SortFunction = void (*)(PointT*);
+    static constexpr SortFunction table[] = {&sortFixed<N + 1>...};
+    table[n - 1](points);
+}
+
+template<typename PointT>
+void networkSort(PointT* points, std::size_t n)
+{
+    networkSort(points, n, std::make_index_sequence<BatchHull::NetworkLimit>());
+}
+
+// Writes the hull of one set to `out` and returns its size, which never
+// exceeds the size of the set.
+template<typename T>
+std::size_t hullOfSet(const BasicPoint<T>* first, std::size_t n, BasicPoint<T>* out,
+                      HullScratch<T>& scratch)
+{
+    if (n == 0) {
+        return 0;
+    }
+
+    if (n <= BatchHull::NetworkLimit) {
+        BasicPoint<T> buffer[BatchHull::NetworkLimit];
+        std::copy(first, first + n, buffer);
+
+        networkSort(buffer, n);
+
+        BasicPoint<T> chainBuffer[2 * BatchHull::NetworkLimit];
+        const std::size_t count = monotoneChainSorted(buffer, n, chainBuffer);
+        std::copy(chainBuffer, chainBuffer + count, out);
+        return count;
+    }
+
+    std::vector<BasicPoint<T>>& sorted = scratch.sorted;
+    std::vector<BasicPoint<T>>& chain = scratch.chain;
+    sorted.assign(first, first + n);
+    std::sort(sorted.begin(), sorted.end(), [](const BasicPoint<T>& a, const BasicPoint<T>& b) {
+        return lexicographicLess(a, b);
+    });
+
+    if (chain.size() < 2 * n) {
+        chain.resize(2 * n);
+    }
+
+    const std::size_t count = monotoneChainSorted(sorted.data(), n, chain.data());
+    std::copy(chain.begin(), chain.begin() + count, out);
+    return count;
+}
+
+// Each hull is first written to the staging buffer at its set's input offset
+// (a hull is never larger than its set), then compacted into the output once
+// the sizes are known. Every task of SetsPerTask sets has its own scratch
+// slot, indexed by the task rather than the thread, so a single-threaded
+// call that covers several tasks still finds them.
+template<typename T>
+void computeBatch(const BasicPointSets<T>& input, BasicPointSets<T>& output,
+                  std::vector<std::uint32_t>& hullSizes,
+                  std::vector<BasicPoint<T>>& staging,
+                  std::vector<HullScratch<T>>& scratch)
+{
+    const std::size_t setCount = input.size();
+
+    hullSizes.resize(setCount);
+    if (staging.size() < input.points.size()) {
+        staging.resize(input.points.size());
+    }
+    const std::size_t taskCount = (setCount + SetsPerTask - 1) / SetsPerTask;
+    if (scratch.size() < taskCount) {
+        scratch.resize(taskCount);
+    }
+
+    parallelFor(0, setCount, SetsPerTask, [&](std::size_t firstSet, std::size_t lastSet) {
+        for (std::size_t set = firstSet; set < lastSet; ++set) {
+            const std::uint32_t begin = input.offsets[set];
+            const std::uint32_t end = input.offsets[set + 1];
+            hullSizes[set] = static_cast<std::uint32_t>(
+                hullOfSet(input.points.data() + begin, end - begin,
+                          staging.data() + begin, scratch[set / SetsPerTask]));
+        }
+    });
+
+    output.offsets.resize(setCount + 1);
+    output.offsets[0] = 0;
+    for (std::size_t set = 0; set < setCount; ++set) {
+        output.offsets[set + 1] = output.offsets[set] + hullSizes[set];
+    }
+    output.points.resize(output.offsets[setCount]);
+
+    parallelFor(0, setCount, SetsPerTask, [&](std::size_t firstSet, std::size_t lastSet) {
+        for (std::size_t set = firstSet; set < lastSet; ++set) {
+            const auto source = staging.begin() + input.offsets[set];
+            std::copy(source, source + hullSizes[set], output.points.begin() + output.offsets[set]);
+        }
+    });
+}
+
+} // namespace
+
+void BatchHull::compute(const PointSets& input, PointSets& output)
+{
+    computeBatch(input, output, m_hullSizes, m_staging, m_scratch);
+}
+
+void BatchHull::compute(const PointSetsI& input, PointSetsI& output)
+{
+    computeBatch(input, output, m_hullSizes, m_stagingI, m_scratchI);
+}
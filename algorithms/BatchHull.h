@@ -0,0 +1,62 @@
+#ifndef BATCHHULL_H
+#define BATCHHULL_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../geometry/Point.h"
+#include "HullScratch.h"
+
+// Many independent point sets packed into one buffer: set i consists of
+// points[offsets[i]] .. points[offsets[i + 1] - 1], so `offsets` has one more
+// entry than there are sets.
+template<typename T>
+struct BasicPointSets
+{
+    std::vector<std::uint32_t> offsets{0};
+    std::vector<BasicPoint<T>> points;
+
+    std::size_t size() const
+    {
+        return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+
+    void clear()
+    {
+        offsets.assign(1, 0);
+        points.clear();
+    }
+
+    void append(const BasicPoint<T>* first, const BasicPoint<T>* last)
+    {
+        points.insert(points.end(), first, last);
+        offsets.push_back(static_cast<std::uint32_t>(points.size()));
+    }
+};
+
+using PointSets = BasicPointSets<double>;
+using PointSetsI = BasicPointSets<std::int32_t>;
+
+// Throughput entry point for hulls of many small, independent point sets.
+// Sets are processed in parallel with Andrew's monotone chain; sets of up to
+// 16 points are sorted with a fixed sorting network on the stack, larger ones
+// with std::sort in per-task buffers. The hulls come back packed the same
+// way as the input, each counter-clockwise. All buffers are kept between
+// calls, so repeating a batch of the same shape does not allocate.
+class BatchHull
+{
+public:
+    static constexpr std::size_t NetworkLimit = 16;
+
+    void compute(const PointSets& input, PointSets& output);
+    void compute(const PointSetsI& input, PointSetsI& output);
+
+private:
+    std::vector<std::uint32_t> m_hullSizes;
+    std::vector<Point> m_staging;
+    std::vector<PointI> m_stagingI;
+    std::vector<HullScratch<double>> m_scratch;
+    std::vector<HullScratch<std::int32_t>> m_scratchI;
+};
+
+#endif // BATCHHULL_H
@@ -4,6 +4,7 @@
 #include <QString>
 #include <vector>
 #include "../geometry/Point.h"
+#include "../geometry/PointConversion.h"
 
 struct AnimationStep {
     enum Type {
@@ -26,6 +27,35 @@ public:
     virtual ~ConvexHullAlgorithm() = default;
 
     virtual std::vector<Point> computeHull(const std::vector<Point>& points) = 0;
+
+    // Exact hull of integer points. Algorithms with an integer kernel override
+    // this; the default goes through the double version.
+    virtual std::vector<PointI> computeHull(const std::vector<PointI>& points)
+    {
+        return toIntegerPointsUnchecked(computeHull(toPoints(points)));
+    }
+
+    // Allocation-free variants: the hull is written into `hull`, reusing its
+    // capacity, and implementations keep their working buffers between calls.
+    // An algorithm object must therefore not run two computations at once.
+    virtual void computeHullInto(const std::vector<Point>& points, std::vector<Point>& hull)
+    {
+        hull = computeHull(points);
+    }
+
+    virtual void computeHullInto(const std::vector<PointI>& points, std::vector<PointI>& hull)
+    {
+        hull = computeHull(points);
+    }
+
+    // Heap memory currently held by the scratch buffers.
+    virtual std::size_t scratchBytes() const
+    {
+        return 0;
+    }
+
+    virtual void releaseScratch() {}
+
     virtual std::vector<AnimationStep> generateSteps(const std::vector<Point>& points) = 0;
     virtual QString name() const = 0;
 };
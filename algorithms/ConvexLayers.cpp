@@ -0,0 +1,130 @@
+#include "ConvexLayers.h"
+#include "MonotoneChain.h"
+#include "../geometry/Orientation.h"
+#include "../geometry/PointConversion.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+constexpr std::uint32_t Unlinked = ~std::uint32_t(0);
+}
+
+// Quantized inputs take the exact integer predicates, like the hull
+// algorithms do.
+void ConvexLayers::compute(const std::vector<Point>& points)
+{
+    std::vector<PointI> integerPoints;
+    if (toIntegerPoints(points, integerPoints)) {
+        peel(integerPoints);
+    } else {
+        peel(points);
+    }
+}
+
+std::size_t ConvexLayers::layerCount() const
+{
+    return m_layers.size();
+}
+
+const std::vector<Point>& ConvexLayers::layer(std::size_t index) const
+{
+    return m_layers[index];
+}
+
+const std::vector<std::uint32_t>& ConvexLayers::depths() const
+{
+    return m_depths;
+}
+
+template<typename T>
+void ConvexLayers::peel(const std::vector<BasicPoint<T>>& points)
+{
+    const std::size_t n = points.size();
+    m_layers.clear();
+    m_depths.assign(n, 0);
+
+    m_members.resize(n);
+    std::iota(m_members.begin(), m_members.end(), 0u);
+    std::sort(m_members.begin(), m_members.end(), [&points](std::uint32_t a, std::uint32_t b) {
+        return lexicographicLess(points[a], points[b]);
+    });
+
+    // Copies of a point are peeled together as one list node; keeping them
+    // apart would make the chain see zero-length edges.
+    std::vector<BasicPoint<T>> distinct;
+    m_groupStart.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+        const BasicPoint<T>& p = points[m_members[i]];
+        if (distinct.empty() || distinct.back().x != p.x || distinct.back().y != p.y) {
+            distinct.push_back(p);
+            m_groupStart.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+    m_groupStart.push_back(static_cast<std::uint32_t>(n));
+
+    // Node m is the sentinel: m_next[m] is the first live point, m_previous[m]
+    // the last.
+    const std::uint32_t m = static_cast<std::uint32_t>(distinct.size());
+    m_next.resize(m + 1);
+    m_previous.resize(m + 1);
+    for (std::uint32_t u = 0; u <= m; ++u) {
+        m_next[u] = u == m ? 0 : u + 1;
+        m_previous[u] = u == 0 ? m : u - 1;
+    }
+    if (m == 0) {
+        return;
+    }
+
+    std::size_t alive = m;
+    while (alive > 0) {
+        // Both chains pop on clockwise turns only, so points on hull edges
+        // stay in the chain and are peeled with the layer.
+        m_chain.clear();
+        for (std::uint32_t u = m_next[m]; u != m; u = m_next[u]) {
+            while (m_chain.size() >= 2 &&
+                   orientation(distinct[m_chain[m_chain.size() - 2]], distinct[m_chain.back()], distinct[u]) ==
+                       Orientation::ClockWise)
+            {
+                m_chain.pop_back();
+            }
+            m_chain.push_back(u);
+        }
+
+        const std::size_t lowerSize = m_chain.size() + 1;
+        for (std::uint32_t u = m_previous[m_previous[m]]; u != m; u = m_previous[u]) {
+            while (m_chain.size() >= lowerSize &&
+                   orientation(distinct[m_chain[m_chain.size() - 2]], distinct[m_chain.back()], distinct[u]) ==
+                       Orientation::ClockWise)
+            {
+                m_chain.pop_back();
+            }
+            m_chain.push_back(u);
+        }
+
+        // The upper chain ends where the lower one started.
+        if (m_chain.size() > 1) {
+            m_chain.pop_back();
+        }
+
+        const std::uint32_t depth = static_cast<std::uint32_t>(m_layers.size());
+        std::vector<Point> boundary;
+        boundary.reserve(m_chain.size());
+        for (std::uint32_t u : m_chain) {
+            boundary.emplace_back(distinct[u].x, distinct[u].y);
+
+            if (m_previous[u] == Unlinked) {
+                continue;
+            }
+            m_next[m_previous[u]] = m_next[u];
+            m_previous[m_next[u]] = m_previous[u];
+            m_previous[u] = Unlinked;
+            --alive;
+
+            for (std::uint32_t i = m_groupStart[u]; i < m_groupStart[u + 1]; ++i) {
+                m_depths[m_members[i]] = depth;
+            }
+        }
+        m_layers.push_back(std::move(boundary));
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef CONVEXLAYERS_H
+#define CONVEXLAYERS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../geometry/Point.h"
+
+// Onion peeling: layer 0 is every point on the boundary of the hull, layer 1
+// every point on the boundary of the hull of the rest, and so on. Points on
+// hull edges belong to the layer, as do all copies of a repeated point.
+//
+// The points are sorted once and the distinct ones are kept in a doubly
+// linked list in that order. Each layer is one monotone chain pass over the
+// list that keeps collinear points, after which its points are unlinked, so
+// the total cost is O(n log n + n * L) for L layers with no re-sorting.
+class ConvexLayers
+{
+public:
+    void compute(const std::vector<Point>& points);
+
+    std::size_t layerCount() const;
+    // Boundary of one layer, counter-clockwise and including collinear
+    // points. A layer whose points are all collinear runs there and back.
+    const std::vector<Point>& layer(std::size_t index) const;
+    // Layer of every input point, in input order.
+    const std::vector<std::uint32_t>& depths() const;
+
+private:
+    template<typename T>
+    void peel(const std::vector<BasicPoint<T>>& points);
+
+private:
+    std::vector<std::vector<Point>> m_layers;
+    std::vector<std::uint32_t> m_depths;
+
+    // Distinct points in sorted order, each with the input indices sharing
+    // its coordinates: m_members[m_groupStart[u]] up to m_groupStart[u + 1].
+    std::vector<std::uint32_t> m_members;
+    std::vector<std::uint32_t> m_groupStart;
+    std::vector<std::uint32_t> m_next;
+    std::vector<std::uint32_t> m_previous;
+    std::vector<std::uint32_t> m_chain;
+};
+
+#endif // CONVEXLAYERS_H
@@ -4,11 +4,18 @@
 #include <algorithm>
 #include <cmath>
 
-std::vector<Point>
-GrahamScan::computeHull(const std::vector<Point>& points)
+namespace {
+
+template<typename T>
+void grahamScan(const std::vector<BasicPoint<T>>& points,
+                HullScratch<T>& scratch,
+                std::vector<BasicPoint<T>>& hull)
 {
-    if (points.size() < 3) {
-        return points;
+    using PointT = BasicPoint<T>;
+
+    if (points.empty()) {
+        hull.clear();
+        return;
     }
 
     int pivotIndex = 0;
@@ -21,65 +28,103 @@ GrahamScan::computeHull(const std::vector<Point>& points)
         }
     }
 
-    Point pivot = points[pivotIndex];
+    PointT pivot = points[pivotIndex];
 
-    std::vector<Point> pts;
-    for (int i = 0; i < points.size(); ++i) {
-        if (i != pivotIndex) {
-            pts.push_back(points[i]);
+    // Copies of the pivot have no polar angle and would break the ordering.
+    std::vector<PointT>& pts = scratch.sorted;
+    pts.clear();
+    for (const PointT& p : points) {
+        if (p.x != pivot.x || p.y != pivot.y) {
+            pts.push_back(p);
         }
     }
 
+    if (pts.empty()) {
+        hull.assign(1, pivot);
+        return;
+    }
+
     std::sort(pts.begin(), pts.end(),
-              [&pivot](const Point& a, const Point& b){
+              [&pivot](const PointT& a, const PointT& b){
 
         Orientation o = orientation(pivot, a, b);
         if (o == Orientation::Collinear) {
-            double da =
-                (a.x - pivot.x) * (a.x - pivot.x) +
-                (a.y - pivot.y) * (a.y - pivot.y);
-            double db =
-                (b.x - pivot.x) * (b.x - pivot.x) +
-                (b.y - pivot.y) * (b.y - pivot.y);
-
-            return da < db;
+            return squaredDistance(pivot, a) < squaredDistance(pivot, b);
         }
 
         return o == Orientation::CounterClockWise;
     });
 
-    std::vector<Point> hull;
-    hull.push_back(pivot);
-    hull.push_back(pts[0]);
-    hull.push_back(pts[1]);
+    std::vector<PointT>& stack = scratch.chain;
+    if (stack.size() < points.size()) {
+        stack.resize(points.size());
+    }
 
-    for (int i = 2; i < pts.size(); ++i) {
-        while (hull.size() >= 2) {
-            const Point& p1 = hull[hull.size() - 2];
-            const Point& p2 = hull[hull.size() - 1];
-            const Point& p3 = pts[i];
+    // The first sorted point is pushed unchecked as well; it is popped like
+    // any other if the next one turns out to be collinear and farther away.
+    std::size_t k = 0;
+    stack[k++] = pivot;
+    stack[k++] = pts[0];
 
-            if (orientation(p1, p2, p3) == Orientation::CounterClockWise) {
-                break;
-            }
+    for (int i = 1; i < pts.size(); ++i) {
+        const PointT& p3 = pts[i];
 
-            hull.pop_back();
+        while (k >= 2 && orientation(stack[k - 2], stack[k - 1], p3) != Orientation::CounterClockWise) {
+            --k;
         }
-        hull.push_back(pts[i]);
+        stack[k++] = p3;
     }
 
+    hull.assign(stack.begin(), stack.begin() + k);
+}
+
+} // namespace
+
+std::vector<Point>
+GrahamScan::computeHull(const std::vector<Point>& points)
+{
+    std::vector<Point> hull;
+    computeHullInto(points, hull);
+    return hull;
+}
+
+std::vector<PointI>
+GrahamScan::computeHull(const std::vector<PointI>& points)
+{
+    std::vector<PointI> hull;
+    computeHullInto(points, hull);
     return hull;
 }
 
+void GrahamScan::computeHullInto(const std::vector<Point>& points, std::vector<Point>& hull)
+{
+    grahamScan(points, m_scratch, hull);
+}
+
+void GrahamScan::computeHullInto(const std::vector<PointI>& points, std::vector<PointI>& hull)
+{
+    grahamScan(points, m_scratchI, hull);
+}
+
+std::size_t GrahamScan::scratchBytes() const
+{
+    return m_scratch.bytes() + m_scratchI.bytes();
+}
+
+void GrahamScan::releaseScratch()
+{
+    m_scratch.release();
+    m_scratchI.release();
+}
+
 std::vector<AnimationStep>
 GrahamScan::generateSteps(const std::vector<Point>& points)
 {
     std::vector<AnimationStep> steps;
 
-    if (points.size() < 3) {
+    if (points.empty()) {
         AnimationStep finalStep;
         finalStep.type = AnimationStep::FINAL_HULL;
-        finalStep.currentHull = points;
         finalStep.description = "Not enough points for hull";
         steps.push_back(finalStep);
         return steps;
@@ -105,12 +150,21 @@ GrahamScan::generateSteps(const std::vector<Point>& points)
     steps.push_back(pivotStep);
 
     std::vector<Point> pts;
-    for (int i = 0; i < points.size(); ++i) {
-        if (i != pivotIndex) {
-            pts.push_back(points[i]);
+    for (const Point& p : points) {
+        if (p.x != pivot.x || p.y != pivot.y) {
+            pts.push_back(p);
         }
     }
 
+    if (pts.empty()) {
+        AnimationStep finalStep;
+        finalStep.type = AnimationStep::FINAL_HULL;
+        finalStep.currentHull = {pivot};
+        finalStep.description = "All points coincide with the pivot";
+        steps.push_back(finalStep);
+        return steps;
+    }
+
     std::sort(pts.begin(), pts.end(),
               [&pivot](const Point& a, const Point& b){
                   Orientation o = orientation(pivot, a, b);
@@ -135,16 +189,15 @@ GrahamScan::generateSteps(const std::vector<Point>& points)
     std::vector<Point> hull;
     hull.push_back(pivot);
     hull.push_back(pts[0]);
-    hull.push_back(pts[1]);
 
     AnimationStep initStep;
     initStep.type = AnimationStep::ADD_TO_HULL;
-    initStep.points = {pivot, pts[0], pts[1]};
+    initStep.points = {pivot, pts[0]};
     initStep.currentHull = hull;
-    initStep.description = "Initialize hull with pivot and first 2 points";
+    initStep.description = "Initialize hull with pivot and first point";
     steps.push_back(initStep);
 
-    for (int i = 2; i < pts.size(); ++i) {
+    for (int i = 1; i < pts.size(); ++i) {
         const Point& currentPoint = pts[i];
 
         AnimationStep processStep;
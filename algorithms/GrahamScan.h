@@ -2,6 +2,7 @@
 #define GRAHAMSCAN_H
 
 #include "ConvexHullAlgorithm.h"
+#include "HullScratch.h"
 
 class GrahamScan : public ConvexHullAlgorithm
 {
@@ -10,8 +11,17 @@ public:
     ~GrahamScan() override = default;
 
     std::vector<Point> computeHull(const std::vector<Point>& points) override;
+    std::vector<PointI> computeHull(const std::vector<PointI>& points) override;
+    void computeHullInto(const std::vector<Point>& points, std::vector<Point>& hull) override;
+    void computeHullInto(const std::vector<PointI>& points, std::vector<PointI>& hull) override;
+    std::size_t scratchBytes() const override;
+    void releaseScratch() override;
     std::vector<AnimationStep> generateSteps(const std::vector<Point>& points) override;
     QString name() const override;
+
+private:
+    HullScratch<double> m_scratch;
+    HullScratch<std::int32_t> m_scratchI;
 };
 
 #endif // GRAHAMSCAN_H
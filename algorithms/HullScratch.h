@@ -0,0 +1,30 @@
+#ifndef HULLSCRATCH_H
+#define HULLSCRATCH_H
+
+#include <cstddef>
+#include <vector>
+
+#include "../geometry/Point.h"
+
+// Working buffers an algorithm keeps between computeHullInto() calls. They
+// only ever grow, so once they have seen the largest input no further heap
+// allocation happens.
+template<typename T>
+struct HullScratch
+{
+    std::vector<BasicPoint<T>> sorted;
+    std::vector<BasicPoint<T>> chain;
+
+    std::size_t bytes() const
+    {
+        return (sorted.capacity() + chain.capacity()) * sizeof(BasicPoint<T>);
+    }
+
+    void release()
+    {
+        std::vector<BasicPoint<T>>().swap(sorted);
+        std::vector<BasicPoint<T>>().swap(chain);
+    }
+};
+
+#endif // HULLSCRATCH_H
@@ -0,0 +1,137 @@
+#include "HullSummary.h"
+#include "MonotoneChain.h"
+#include "../geometry/Orientation.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr std::uint32_t Magic = 0x4d534843; // "CHSM"
+constexpr std::uint32_t Version = 1;
+
+struct Header
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t pointCount;
+    std::uint64_t vertexCount;
+};
+
+bool pointLess(const Point& a, const Point& b)
+{
+    return lexicographicLess(a, b);
+}
+
+// The invariant merge relies on: strictly convex, counter-clockwise, first
+// vertex lexicographically smallest.
+bool isCanonicalHull(const std::vector<Point>& hull)
+{
+    const std::size_t h = hull.size();
+    for (std::size_t i = 1; i < h; ++i) {
+        if (!pointLess(hull[0], hull[i])) {
+            return false;
+        }
+    }
+    if (h < 3) {
+        return true;
+    }
+    for (std::size_t i = 0; i < h; ++i) {
+        if (orientation(hull[i], hull[(i + 1) % h], hull[(i + 2) % h]) != Orientation::CounterClockWise) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+HullSummary HullSummary::fromHull(std::vector<Point> hull, std::uint64_t pointCount)
+{
+    std::rotate(hull.begin(), std::min_element(hull.begin(), hull.end(), pointLess), hull.end());
+
+    HullSummary summary;
+    summary.m_hull = std::move(hull);
+    summary.m_pointCount = pointCount;
+    return summary;
+}
+
+HullSummary HullSummary::merge(const HullSummary& a, const HullSummary& b)
+{
+    std::vector<Point> sortedA;
+    std::vector<Point> sortedB;
+    a.appendSorted(sortedA);
+    b.appendSorted(sortedB);
+
+    std::vector<Point> sorted(sortedA.size() + sortedB.size());
+    std::merge(sortedA.begin(), sortedA.end(), sortedB.begin(), sortedB.end(), sorted.begin(), pointLess);
+
+    HullSummary summary;
+    summary.m_hull.resize(2 * sorted.size());
+    summary.m_hull.resize(monotoneChainSorted(sorted.data(), sorted.size(), summary.m_hull.data()));
+    summary.m_pointCount = a.m_pointCount + b.m_pointCount;
+    return summary;
+}
+
+const std::vector<Point>& HullSummary::hull() const
+{
+    return m_hull;
+}
+
+std::uint64_t HullSummary::pointCount() const
+{
+    return m_pointCount;
+}
+
+void HullSummary::appendSorted(std::vector<Point>& out) const
+{
+    if (m_hull.empty()) {
+        return;
+    }
+
+    // The lower chain runs from vertex 0 up to the largest vertex, the upper
+    // chain from there back down; walking the upper chain backwards makes
+    // both ascending.
+    const std::size_t last = std::max_element(m_hull.begin(), m_hull.end(), pointLess) - m_hull.begin();
+    const std::size_t first = out.size();
+    out.resize(first + m_hull.size());
+    std::merge(m_hull.begin(), m_hull.begin() + last + 1,
+               m_hull.rbegin(), m_hull.rend() - last - 1,
+               out.begin() + first, pointLess);
+}
+
+void HullSummary::serialize(std::string& out) const
+{
+    Header header;
+    header.magic = Magic;
+    header.version = Version;
+    header.pointCount = m_pointCount;
+    header.vertexCount = m_hull.size();
+
+    out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.append(reinterpret_cast<const char*>(m_hull.data()), m_hull.size() * sizeof(Point));
+}
+
+std::size_t HullSummary::deserialize(const char* data, std::size_t size, HullSummary& out)
+{
+    Header header;
+    if (size < sizeof(header)) {
+        return 0;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != Magic || header.version != Version ||
+        header.vertexCount > (size - sizeof(header)) / sizeof(Point))
+    {
+        return 0;
+    }
+
+    std::vector<Point> hull(header.vertexCount);
+    std::memcpy(hull.data(), data + sizeof(header), hull.size() * sizeof(Point));
+    if (!isCanonicalHull(hull)) {
+        return 0;
+    }
+
+    out.m_hull = std::move(hull);
+    out.m_pointCount = header.pointCount;
+    return sizeof(header) + out.m_hull.size() * sizeof(Point);
+}
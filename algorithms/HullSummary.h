@@ -0,0 +1,49 @@
+#ifndef HULLSUMMARY_H
+#define HULLSUMMARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../geometry/Point.h"
+
+// Everything a reducer needs to know about one shard of points: its hull
+// and how many points it summarizes. Shards compute their hulls with any
+// ConvexHullAlgorithm and ship only the summary; summaries merge in
+// O(h1 + h2) into the summary of the union, so a tree of merges gives the
+// hull of all shards.
+//
+// The hull is kept strictly convex and counter-clockwise from its
+// lexicographically smallest vertex. That order already splits it into a
+// lower chain sorted ascending and an upper chain sorted descending, so a
+// merge is a linear merge of the sorted vertices followed by the monotone
+// chain.
+class HullSummary
+{
+public:
+    HullSummary() = default;
+
+    // `hull` as returned by a ConvexHullAlgorithm, starting at any vertex.
+    static HullSummary fromHull(std::vector<Point> hull, std::uint64_t pointCount);
+    static HullSummary merge(const HullSummary& a, const HullSummary& b);
+
+    const std::vector<Point>& hull() const;
+    std::uint64_t pointCount() const;
+
+    // Appends a binary form in host byte order, for processes on one machine.
+    void serialize(std::string& out) const;
+    // Reads one summary from the start of `data`. Returns the number of bytes
+    // used, or 0 if the data is truncated or is not a valid summary.
+    static std::size_t deserialize(const char* data, std::size_t size, HullSummary& out);
+
+private:
+    // Vertices in lexicographic order, merged from the two chains.
+    void appendSorted(std::vector<Point>& out) const;
+
+private:
+    std::vector<Point> m_hull;
+    std::uint64_t m_pointCount = 0;
+};
+
+#endif // HULLSUMMARY_H
@@ -0,0 +1,322 @@
+#include "KineticHull.h"
+#include "MonotoneChain.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Repairing the carried-over order costs one shift per inversion. Beyond
+// this many shifts per point a fresh std::sort is cheaper.
+constexpr std::size_t MaxMovesPerPoint = 8;
+
+constexpr int MinSectors = 8;
+constexpr int MaxSectors = 1 << 14;
+
+// Monotonic stand-in for atan2 with range [0, 4): one quarter turn per unit.
+// Between adjacent quadrant boundaries it grows at least as fast as the
+// angle in radians, so a sector 4 / n wide spans at least 4 / n radians.
+inline double pseudoAngle(double dx, double dy)
+{
+    if (dy >= 0.0) {
+        return dx >= 0.0 ? dy / (dx + dy) : 1.0 - dx / (dy - dx);
+    }
+    return dx < 0.0 ? 2.0 - dy / (-dx - dy) : 3.0 + dx / (dx - dy);
+}
+
+} // namespace
+
+const std::vector<Point>& KineticHull::update(const std::vector<Point>& points)
+{
+    m_stats = Stats();
+
+    bool warm = points.size() == m_previous.size() && m_hull.size() >= 3;
+    if (warm) {
+        m_stats.maxMotion = measureMotion(points);
+        const double slack = 1e-9 * (std::abs(m_center.x) + std::abs(m_center.y) + m_innerRadius);
+        warm = collectCandidates(points, m_stats.maxMotion + slack);
+    }
+
+    if (!warm) {
+        rebuild(points);
+    }
+
+    // m_merged holds the sorted candidates either way.
+    m_candidateOrder.resize(m_merged.size());
+    m_candidates.resize(m_merged.size());
+    for (std::size_t i = 0; i < m_merged.size(); ++i) {
+        m_candidateOrder[i] = m_merged[i].index;
+        m_candidates[i] = m_merged[i].p;
+    }
+    m_stats.candidates = m_candidates.size();
+
+    if (m_chain.size() < 2 * m_candidates.size()) {
+        m_chain.resize(2 * m_candidates.size());
+    }
+    const std::size_t count = monotoneChainSorted(m_candidates.data(), m_candidates.size(), m_chain.data());
+    m_hull.assign(m_chain.begin(), m_chain.begin() + count);
+
+    prepareFilter();
+    return m_hull;
+}
+
+void KineticHull::reset()
+{
+    m_previous.clear();
+    m_candidateOrder.clear();
+    m_pending.clear();
+    m_merged.clear();
+    m_candidates.clear();
+    m_hull.clear();
+    m_edges.clear();
+    m_innerRadius = 0.0;
+    m_stats = Stats();
+}
+
+const std::vector<Point>& KineticHull::hull() const
+{
+    return m_hull;
+}
+
+const KineticHull::Stats& KineticHull::lastStats() const
+{
+    return m_stats;
+}
+
+// Every point becomes a candidate and is sorted from scratch.
+void KineticHull::rebuild(const std::vector<Point>& points)
+{
+    m_merged.resize(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        m_merged[i] = Entry{points[i], static_cast<std::uint32_t>(i)};
+    }
+
+    std::sort(m_merged.begin(), m_merged.end(), [](const Entry& a, const Entry& b) {
+        return lexicographicLess(a.p, b.p);
+    });
+
+    m_previous.assign(points.begin(), points.end());
+    m_pending.assign(points.size(), 0);
+    m_stats.maxMotion = std::numeric_limits<double>::infinity();
+    m_stats.entered = points.size();
+    m_stats.rebuilt = true;
+}
+
+// Largest displacement since the previous update. Also records the new
+// positions for the next one.
+double KineticHull::measureMotion(const std::vector<Point>& points)
+{
+    double maxMotionSquared = 0.0;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        const double dx = points[i].x - m_previous[i].x;
+        const double dy = points[i].y - m_previous[i].y;
+        maxMotionSquared = std::max(maxMotionSquared, dx * dx + dy * dy);
+        m_previous[i] = points[i];
+    }
+    return std::sqrt(maxMotionSquared);
+}
+
+// Every point moved by at most d, so in every direction the support function
+// of the new hull is at least that of the previous hull minus d. The new hull
+// therefore contains the previous one shrunk by d, and points more than d
+// inside the previous hull cannot be vertices. The remaining points end up in
+// m_merged in lexicographic order. Returns false if the motion is too large
+// for the previous hull to rule anything out.
+bool KineticHull::collectCandidates(const std::vector<Point>& points, double margin)
+{
+    if (!(m_innerRadius > margin) || !buildSectors(margin)) {
+        return false;
+    }
+
+    const double innerSquared = (m_innerRadius - margin) * (m_innerRadius - margin);
+
+    m_found.clear();
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        const Point& p = points[i];
+        const double dx = p.x - m_center.x;
+        const double dy = p.y - m_center.y;
+        if (dx * dx + dy * dy < innerSquared || isDeepInside(p, margin)) {
+            continue;
+        }
+        m_found.push_back(static_cast<std::uint32_t>(i));
+        m_pending[i] = 1;
+    }
+
+    // Candidates of the previous update first, in their old order...
+    m_carried.clear();
+    for (std::uint32_t index : m_candidateOrder) {
+        if (m_pending[index]) {
+            m_carried.push_back(Entry{points[index], index});
+            m_pending[index] = 0;
+        }
+    }
+
+    // ...then the ones that moved into the band, still marked pending.
+    m_entered.clear();
+    for (std::uint32_t index : m_found) {
+        if (m_pending[index]) {
+            m_entered.push_back(Entry{points[index], index});
+            m_pending[index] = 0;
+        }
+    }
+    m_stats.entered = m_entered.size();
+
+    const auto less = [](const Entry& a, const Entry& b) {
+        return lexicographicLess(a.p, b.p);
+    };
+
+    if (!repairCarriedOrder()) {
+        std::sort(m_carried.begin(), m_carried.end(), less);
+    }
+    std::sort(m_entered.begin(), m_entered.end(), less);
+
+    m_merged.resize(m_carried.size() + m_entered.size());
+    std::merge(m_carried.begin(), m_carried.end(), m_entered.begin(), m_entered.end(),
+               m_merged.begin(), less);
+    return true;
+}
+
+bool KineticHull::repairCarriedOrder()
+{
+    const std::size_t budget = MaxMovesPerPoint * m_carried.size();
+    std::size_t moves = 0;
+
+    for (std::size_t i = 1; i < m_carried.size(); ++i) {
+        if (!lexicographicLess(m_carried[i].p, m_carried[i - 1].p)) {
+            continue;
+        }
+
+        const Entry entry = m_carried[i];
+        std::size_t j = i;
+        do {
+            m_carried[j] = m_carried[j - 1];
+            --j;
+        } while (j > 0 && lexicographicLess(entry.p, m_carried[j - 1].p));
+        m_carried[j] = entry;
+
+        moves += i - j;
+        if (moves > budget) {
+            m_stats.moves = moves;
+            return false;
+        }
+    }
+
+    m_stats.moves = moves;
+    return true;
+}
+
+// Splits the turn around m_center into equal pseudo-angle sectors and records
+// which edge a ray at the start of each sector crosses. Sectors must stay
+// wide compared to the margin for isDeepInside() to decide anything, and
+// about one edge per sector keeps the per-point test short.
+bool KineticHull::buildSectors(double margin)
+{
+    const double limit = std::min<double>({2.0 * m_edges.size(),
+                                           margin > 0.0 ? 2.0 * m_innerRadius / margin : MaxSectors,
+                                           static_cast<double>(MaxSectors)});
+    int sectors = MinSectors;
+    while (sectors * 2 <= limit) {
+        sectors *= 2;
+    }
+    if (sectors > limit) {
+        return false;
+    }
+
+    m_sectorCount = sectors;
+    m_sectorSine = std::sin(4.0 / sectors);
+    m_sectorFirstEdge.resize(sectors);
+
+    const std::size_t h = m_vertexAngles.size();
+    const std::size_t first = std::min_element(m_vertexAngles.begin(), m_vertexAngles.end()) -
+                              m_vertexAngles.begin();
+
+    // Angles grow counter-clockwise from `first`; before it the ray still
+    // crosses the edge that ends there.
+    std::size_t passed = 0;
+    std::size_t edge = (first + h - 1) % h;
+    for (int s = 0; s < sectors; ++s) {
+        const double angle = 4.0 * s / sectors;
+        while (passed < h && m_vertexAngles[(first + passed) % h] <= angle) {
+            edge = (first + passed) % h;
+            ++passed;
+        }
+        m_sectorFirstEdge[s] = static_cast<std::uint32_t>(edge);
+    }
+
+    return true;
+}
+
+// True if the disc of radius `margin` around p lies inside the previous hull.
+// Within a sector the hull is bounded by the edges its rays cross, so it is
+// enough that the disc stays within p's sector and its two neighbours and
+// clears the edges of those three. One extra edge on each side absorbs
+// rounding in the vertex angles.
+bool KineticHull::isDeepInside(const Point& p, double margin) const
+{
+    const double dx = p.x - m_center.x;
+    const double dy = p.y - m_center.y;
+    if ((dx * dx + dy * dy) * m_sectorSine * m_sectorSine <= margin * margin) {
+        return false;
+    }
+
+    const int s = std::min(static_cast<int>(pseudoAngle(dx, dy) * m_sectorCount / 4.0),
+                           m_sectorCount - 1);
+    // Three sectors cover less than half a turn, so the edge range between
+    // them never wraps all the way around.
+    const std::size_t h = m_edges.size();
+    const std::size_t firstEdge = m_sectorFirstEdge[(s + m_sectorCount - 1) % m_sectorCount];
+    const std::size_t lastEdge = m_sectorFirstEdge[(s + 2) % m_sectorCount];
+    const std::size_t count = std::min(h, (lastEdge + h - firstEdge) % h + 3);
+
+    std::size_t edge = (firstEdge + h - 1) % h;
+    for (std::size_t checked = 0; checked < count; ++checked) {
+        const EdgeLine& line = m_edges[edge];
+        if (line.nx * p.x + line.ny * p.y + line.offset <= margin) {
+            return false;
+        }
+        edge = edge + 1 == h ? 0 : edge + 1;
+    }
+    return true;
+}
+
+// Edge lines, vertex angles and the inner disc of the hull just computed,
+// for the next update. The vertex centroid lies inside the hull; the disc
+// around it reaches the nearest edge line.
+void KineticHull::prepareFilter()
+{
+    m_innerRadius = 0.0;
+    m_edges.clear();
+    m_vertexAngles.clear();
+
+    const std::size_t h = m_hull.size();
+    if (h < 3) {
+        return;
+    }
+
+    double cx = 0.0;
+    double cy = 0.0;
+    for (const Point& v : m_hull) {
+        cx += v.x;
+        cy += v.y;
+    }
+    m_center = Point(cx / h, cy / h);
+
+    double radius = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < h; ++i) {
+        const Point& a = m_hull[i];
+        const Point& b = m_hull[(i + 1) % h];
+        const double length = std::hypot(b.x - a.x, b.y - a.y);
+
+        EdgeLine line;
+        line.nx = -(b.y - a.y) / length;
+        line.ny = (b.x - a.x) / length;
+        line.offset = -(line.nx * a.x + line.ny * a.y);
+        m_edges.push_back(line);
+
+        radius = std::min(radius, line.nx * m_center.x + line.ny * m_center.y + line.offset);
+        m_vertexAngles.push_back(pseudoAngle(a.x - m_center.x, a.y - m_center.y));
+    }
+
+    m_innerRadius = std::max(radius, 0.0);
+}
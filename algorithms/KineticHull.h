@@ -0,0 +1,96 @@
+#ifndef KINETICHULL_H
+#define KINETICHULL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../geometry/Point.h"
+
+// Warm-started hull for a point cloud whose points move a little between
+// updates, point i of one update being point i of the previous one. With a
+// motion bound d measured on the way in, every point deeper than d inside
+// the previous hull stays strictly inside the new one, so only the thin band
+// along the previous boundary goes through the monotone chain. Points that
+// were already in the band keep the previous update's lexicographic order,
+// which an insertion sort repairs; points entering the band are sorted on
+// their own and merged in. Per-update cost is a few linear passes for small
+// motions. Results are exact whatever the motion; large motions only lose
+// the speedup.
+class KineticHull
+{
+public:
+    struct Stats {
+        // Points that reached the monotone chain.
+        std::size_t candidates = 0;
+        // Candidates that were not candidates in the previous update.
+        std::size_t entered = 0;
+        // Insertion sort shifts spent repairing the carried-over order.
+        std::size_t moves = 0;
+        // Largest distance any point moved since the previous update.
+        double maxMotion = 0.0;
+        // Everything was sorted from scratch: first update, a changed point
+        // count or motions too large for the previous hull to help.
+        bool rebuilt = false;
+    };
+
+    const std::vector<Point>& update(const std::vector<Point>& points);
+    void reset();
+
+    // Counter-clockwise, starting at the lexicographically smallest vertex.
+    const std::vector<Point>& hull() const;
+    const Stats& lastStats() const;
+
+private:
+    struct Entry {
+        Point p;
+        std::uint32_t index;
+    };
+
+    // Edge line with its inward unit normal: depth(p) = nx * p.x + ny * p.y + offset.
+    struct EdgeLine {
+        double nx;
+        double ny;
+        double offset;
+    };
+
+    void rebuild(const std::vector<Point>& points);
+    double measureMotion(const std::vector<Point>& points);
+    bool collectCandidates(const std::vector<Point>& points, double margin);
+    bool repairCarriedOrder();
+    bool buildSectors(double margin);
+    bool isDeepInside(const Point& p, double margin) const;
+    void prepareFilter();
+
+private:
+    // Positions as of the previous update, in input order.
+    std::vector<Point> m_previous;
+    // Indices of the previous update's candidates in lexicographic order.
+    std::vector<std::uint32_t> m_candidateOrder;
+    // Per point: 1 while it is a candidate not yet placed, else 0.
+    std::vector<std::uint8_t> m_pending;
+    std::vector<std::uint32_t> m_found;
+
+    // This update's candidates: carried over, entering, then both merged.
+    std::vector<Entry> m_carried;
+    std::vector<Entry> m_entered;
+    std::vector<Entry> m_merged;
+    std::vector<Point> m_candidates;
+    std::vector<Point> m_chain;
+    std::vector<Point> m_hull;
+
+    // The previous hull seen from a point inside it: a disc that it contains,
+    // its edge lines and, per angular sector, the first edge a ray in that
+    // sector crosses.
+    Point m_center;
+    double m_innerRadius = 0.0;
+    std::vector<EdgeLine> m_edges;
+    std::vector<double> m_vertexAngles;
+    std::vector<std::uint32_t> m_sectorFirstEdge;
+    int m_sectorCount = 0;
+    double m_sectorSine = 0.0;
+
+    Stats m_stats;
+};
+
+#endif // KINETICHULL_H
@@ -0,0 +1,276 @@
+#include "MelkmanHull.h"
+#include "MonotoneChain.h"
+#include "../geometry/Orientation.h"
+
+#include <algorithm>
+#include <deque>
+
+namespace {
+
+template<typename T>
+bool equalPoints(const BasicPoint<T>& a, const BasicPoint<T>& b)
+{
+    return a.x == b.x && a.y == b.y;
+}
+
+// Lexicographic extremes of the longest collinear prefix. Returns the index
+// of the first point off their line, or n if there is none.
+template<typename T>
+std::size_t collinearPrefix(const std::vector<BasicPoint<T>>& points, BasicPoint<T>& low, BasicPoint<T>& high)
+{
+    low = points[0];
+    high = points[0];
+    std::size_t i = 1;
+    for (; i < points.size(); ++i) {
+        const BasicPoint<T>& p = points[i];
+        if (!equalPoints(low, high) && orientation(low, high, p) != Orientation::Collinear) {
+            break;
+        }
+        if (lexicographicLess(p, low)) {
+            low = p;
+        } else if (lexicographicLess(high, p)) {
+            high = p;
+        }
+    }
+    return i;
+}
+
+// The other algorithms start at the lowest vertex; so does this one, which
+// keeps batch output comparable.
+template<typename T>
+void startAtLowest(std::vector<BasicPoint<T>>& hull)
+{
+    const auto lowest = std::min_element(hull.begin(), hull.end(), [](const BasicPoint<T>& a, const BasicPoint<T>& b) {
+        return lexicographicLess(a, b);
+    });
+    std::rotate(hull.begin(), lowest, hull.end());
+}
+
+template<typename T>
+void melkman(const std::vector<BasicPoint<T>>& points,
+             HullScratch<T>& scratch,
+             std::vector<BasicPoint<T>>& hull)
+{
+    const std::size_t n = points.size();
+    if (n == 0) {
+        hull.clear();
+        return;
+    }
+
+    BasicPoint<T> low;
+    BasicPoint<T> high;
+    const std::size_t next = collinearPrefix(points, low, high);
+    if (next == n) {
+        hull.assign(1, low);
+        if (!equalPoints(low, high)) {
+            hull.push_back(high);
+        }
+        return;
+    }
+
+    // A flat array instead of std::deque: both ends move by at most one slot
+    // per point, so starting in the middle of 2n slots never runs out.
+    std::vector<BasicPoint<T>>& buffer = scratch.chain;
+    if (buffer.size() < 2 * n + 4) {
+        buffer.resize(2 * n + 4);
+    }
+    BasicPoint<T>* deque = buffer.data();
+
+    const BasicPoint<T>& apex = points[next];
+    const bool counterClockwise = orientation(low, high, apex) == Orientation::CounterClockWise;
+    std::size_t bottom = n;
+    std::size_t top = n + 3;
+    deque[bottom] = apex;
+    deque[bottom + 1] = counterClockwise ? low : high;
+    deque[bottom + 2] = counterClockwise ? high : low;
+    deque[top] = apex;
+
+    // Plain cross() rather than orientation(): most points are skipped after
+    // two tests, and the counter orientation() bumps would double their cost.
+    for (std::size_t i = next + 1; i < n; ++i) {
+        const BasicPoint<T>& p = points[i];
+        if (cross(deque[top - 1], deque[top], p) >= 0 &&
+            cross(deque[bottom], deque[bottom + 1], p) >= 0) {
+            continue;
+        }
+
+        while (top - bottom > 2 && cross(deque[top - 1], deque[top], p) <= 0) {
+            --top;
+        }
+        deque[++top] = p;
+
+        while (top - bottom > 2 && cross(deque[bottom], deque[bottom + 1], p) <= 0) {
+            ++bottom;
+        }
+        deque[--bottom] = p;
+    }
+
+    // Both ends hold the last vertex added; the top copy is dropped.
+    hull.assign(deque + bottom, deque + top);
+    startAtLowest(hull);
+}
+
+} // namespace
+
+std::vector<Point>
+MelkmanHull::computeHull(const std::vector<Point>& points)
+{
+    std::vector<Point> hull;
+    computeHullInto(points, hull);
+    return hull;
+}
+
+std::vector<PointI>
+MelkmanHull::computeHull(const std::vector<PointI>& points)
+{
+    std::vector<PointI> hull;
+    computeHullInto(points, hull);
+    return hull;
+}
+
+void MelkmanHull::computeHullInto(const std::vector<Point>& points, std::vector<Point>& hull)
+{
+    melkman(points, m_scratch, hull);
+}
+
+void MelkmanHull::computeHullInto(const std::vector<PointI>& points, std::vector<PointI>& hull)
+{
+    melkman(points, m_scratchI, hull);
+}
+
+std::size_t MelkmanHull::scratchBytes() const
+{
+    return m_scratch.bytes() + m_scratchI.bytes();
+}
+
+void MelkmanHull::releaseScratch()
+{
+    m_scratch.release();
+    m_scratchI.release();
+}
+
+// Each step shows the deque from bottom to top as the current hull, so a
+// pop from either end opens the polygon where the new vertex will go.
+std::vector<AnimationStep>
+MelkmanHull::generateSteps(const std::vector<Point>& points)
+{
+    std::vector<AnimationStep> steps;
+
+    if (points.empty()) {
+        AnimationStep finalStep;
+        finalStep.type = AnimationStep::FINAL_HULL;
+        finalStep.description = "Not enough points for hull";
+        steps.push_back(finalStep);
+        return steps;
+    }
+
+    AnimationStep pathStep;
+    pathStep.type = AnimationStep::HIGHLIGHT_POINT;
+    pathStep.points = points;
+    pathStep.description = QString("Polyline of %1 vertices, taken in order").arg(points.size());
+    steps.push_back(pathStep);
+
+    Point low;
+    Point high;
+    const std::size_t next = collinearPrefix(points, low, high);
+    if (next == points.size()) {
+        AnimationStep finalStep;
+        finalStep.type = AnimationStep::FINAL_HULL;
+        finalStep.currentHull = {low};
+        if (!equalPoints(low, high)) {
+            finalStep.currentHull.push_back(high);
+        }
+        finalStep.description = points.size() < 3 ? "Not enough points for hull" : "All points are collinear";
+        steps.push_back(finalStep);
+        return steps;
+    }
+
+    const Point& apex = points[next];
+    std::deque<Point> deque;
+    if (orientation(low, high, apex) == Orientation::CounterClockWise) {
+        deque = {apex, low, high, apex};
+    } else {
+        deque = {apex, high, low, apex};
+    }
+
+    AnimationStep startStep;
+    startStep.type = AnimationStep::ADD_TO_HULL;
+    startStep.points = {low, high, apex};
+    startStep.currentHull.assign(deque.begin(), deque.end());
+    startStep.description = QString("Started the deque with the triangle ending at (%1, %2)")
+                                .arg(apex.x, 0, 'f', 1).arg(apex.y, 0, 'f', 1);
+    steps.push_back(startStep);
+
+    for (std::size_t i = next + 1; i < points.size(); ++i) {
+        const Point& p = points[i];
+        const bool inside =
+            orientation(deque[deque.size() - 2], deque.back(), p) != Orientation::ClockWise &&
+            orientation(deque[0], deque[1], p) != Orientation::ClockWise;
+
+        AnimationStep processStep;
+        processStep.type = AnimationStep::HIGHLIGHT_POINT;
+        processStep.points = {p};
+        processStep.currentHull.assign(deque.begin(), deque.end());
+        processStep.description = QString(inside ? "Vertex (%1, %2) is inside the hull - skipped"
+                                                 : "Vertex (%1, %2) is outside the hull")
+                                      .arg(p.x, 0, 'f', 1).arg(p.y, 0, 'f', 1);
+        steps.push_back(processStep);
+
+        if (inside) {
+            continue;
+        }
+
+        while (deque.size() > 3 &&
+               orientation(deque[deque.size() - 2], deque.back(), p) != Orientation::CounterClockWise) {
+            const Point removed = deque.back();
+            deque.pop_back();
+
+            AnimationStep removeStep;
+            removeStep.type = AnimationStep::REMOVE_FROM_HULL;
+            removeStep.points = {removed};
+            removeStep.currentHull.assign(deque.begin(), deque.end());
+            removeStep.description = QString("Popped (%1, %2) from the top of the deque")
+                                         .arg(removed.x, 0, 'f', 1).arg(removed.y, 0, 'f', 1);
+            steps.push_back(removeStep);
+        }
+        deque.push_back(p);
+
+        while (deque.size() > 3 && orientation(deque[0], deque[1], p) != Orientation::CounterClockWise) {
+            const Point removed = deque.front();
+            deque.pop_front();
+
+            AnimationStep removeStep;
+            removeStep.type = AnimationStep::REMOVE_FROM_HULL;
+            removeStep.points = {removed};
+            removeStep.currentHull.assign(deque.begin(), deque.end());
+            removeStep.description = QString("Popped (%1, %2) from the bottom of the deque")
+                                         .arg(removed.x, 0, 'f', 1).arg(removed.y, 0, 'f', 1);
+            steps.push_back(removeStep);
+        }
+        deque.push_front(p);
+
+        AnimationStep addStep;
+        addStep.type = AnimationStep::ADD_TO_HULL;
+        addStep.points = {p};
+        addStep.currentHull.assign(deque.begin(), deque.end());
+        addStep.description = QString("Pushed (%1, %2) onto both ends, %3 vertices in the deque")
+                                  .arg(p.x, 0, 'f', 1).arg(p.y, 0, 'f', 1).arg(deque.size() - 1);
+        steps.push_back(addStep);
+    }
+
+    std::vector<Point> hull(deque.begin(), deque.end() - 1);
+    startAtLowest(hull);
+
+    AnimationStep finalStep;
+    finalStep.type = AnimationStep::FINAL_HULL;
+    finalStep.currentHull = hull;
+    finalStep.description = QString("Convex hull complete! %1 points").arg(hull.size());
+    steps.push_back(finalStep);
+
+    return steps;
+}
+
+QString MelkmanHull::name() const
+{
+    return "Melkman (polyline)";
+}
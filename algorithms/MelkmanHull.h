@@ -0,0 +1,37 @@
+#ifndef MELKMANHULL_H
+#define MELKMANHULL_H
+
+#include "ConvexHullAlgorithm.h"
+#include "HullScratch.h"
+
+// Melkman's algorithm: the hull of a simple polyline in O(n), taking the
+// points in the order given instead of sorting them. The hull is kept in a
+// deque whose two ends are the last vertex added. A new vertex left of both
+// edges at that end is inside the hull and skipped; otherwise the vertices
+// it makes reflex are popped from either end and it is pushed onto both.
+//
+// The result is only correct if the polyline does not cross itself, as with
+// tracks, contours or the vertices of a simple polygon. It is therefore not
+// in the AlgorithmRegistry, whose algorithms take arbitrary point sets.
+class MelkmanHull : public ConvexHullAlgorithm
+{
+public:
+    MelkmanHull() = default;
+    ~MelkmanHull() override = default;
+
+    std::vector<Point> computeHull(const std::vector<Point>& points) override;
+    std::vector<PointI> computeHull(const std::vector<PointI>& points) override;
+    void computeHullInto(const std::vector<Point>& points, std::vector<Point>& hull) override;
+    void computeHullInto(const std::vector<PointI>& points, std::vector<PointI>& hull) override;
+    std::size_t scratchBytes() const override;
+    void releaseScratch() override;
+    // Every push and pop on the deque is a step.
+    std::vector<AnimationStep> generateSteps(const std::vector<Point>& points) override;
+    QString name() const override;
+
+private:
+    HullScratch<double> m_scratch;
+    HullScratch<std::int32_t> m_scratchI;
+};
+
+#endif // MELKMANHULL_H
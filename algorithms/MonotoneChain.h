@@ -0,0 +1,60 @@
+#ifndef MONOTONECHAIN_H
+#define MONOTONECHAIN_H
+
+#include <cstddef>
+
+#include "../geometry/Orientation.h"
+
+template<typename T>
+inline bool lexicographicLess(const BasicPoint<T>& a, const BasicPoint<T>& b)
+{
+    if (a.x == b.x) {
+        return a.y < b.y;
+    }
+    return a.x < b.x;
+}
+
+// Andrew's chain over points already sorted by lexicographicLess. Lower and
+// upper hull are written back to back into `chain`, which must have room for
+// 2 * n points. Returns the number of hull vertices, which are the first
+// entries of `chain` in counter-clockwise order. Collinear and repeated points
+// are dropped, so all-equal input yields one vertex and collinear input the
+// two endpoints.
+template<typename T>
+std::size_t monotoneChainSorted(const BasicPoint<T>* sorted, std::size_t n, BasicPoint<T>* chain)
+{
+    if (n == 0) {
+        return 0;
+    }
+
+    const BasicPoint<T>& first = sorted[0];
+    const BasicPoint<T>& last = sorted[n - 1];
+    if (first.x == last.x && first.y == last.y) {
+        chain[0] = first;
+        return 1;
+    }
+
+    std::size_t k = 0;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const BasicPoint<T>& p = sorted[i];
+        while (k >= 2 && orientation(chain[k - 2], chain[k - 1], p) != Orientation::CounterClockWise) {
+            --k;
+        }
+        chain[k++] = p;
+    }
+
+    const std::size_t lowerSize = k + 1;
+    for (std::size_t i = n - 1; i-- > 0;) {
+        const BasicPoint<T>& p = sorted[i];
+        while (k >= lowerSize && orientation(chain[k - 2], chain[k - 1], p) != Orientation::CounterClockWise) {
+            --k;
+        }
+        chain[k++] = p;
+    }
+
+    // The last point of the upper chain is the first point of the lower one.
+    return k - 1;
+}
+
+#endif // MONOTONECHAIN_H
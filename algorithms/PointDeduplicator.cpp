@@ -0,0 +1,225 @@
+#include "PointDeduplicator.h"
+#include "../core/Parallel.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Below this a plain sort-unique wins over the partitioning passes.
+constexpr std::size_t ParallelThreshold = 1 << 16;
+constexpr std::size_t ChunkSize = 1 << 16;
+constexpr unsigned PartitionBits = 8;
+constexpr std::size_t PartitionCount = std::size_t(1) << PartitionBits;
+
+using DoubleKey = PointDeduplicator::DoubleKey;
+
+// Flipping the sign bits keeps the key order equal to the lexicographic
+// order of the coordinates, so each partition comes out sorted the way the
+// hull algorithms sort.
+std::uint64_t pack(const PointI& p)
+{
+    const std::uint64_t x = static_cast<std::uint32_t>(p.x) ^ 0x80000000u;
+    const std::uint64_t y = static_cast<std::uint32_t>(p.y) ^ 0x80000000u;
+    return x << 32 | y;
+}
+
+void unpack(std::uint64_t key, PointI& p)
+{
+    p.x = static_cast<std::int32_t>(static_cast<std::uint32_t>(key >> 32) ^ 0x80000000u);
+    p.y = static_cast<std::int32_t>(static_cast<std::uint32_t>(key) ^ 0x80000000u);
+}
+
+std::uint64_t bitsOf(double value)
+{
+    // -0.0 and 0.0 are the same point.
+    if (value == 0.0) {
+        value = 0.0;
+    }
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double fromBits(std::uint64_t bits)
+{
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+DoubleKey pack(const Point& p)
+{
+    return {bitsOf(p.x), bitsOf(p.y)};
+}
+
+void unpack(const DoubleKey& key, Point& p)
+{
+    p.x = fromBits(key.x);
+    p.y = fromBits(key.y);
+}
+
+struct KeyLess
+{
+    bool operator()(std::uint64_t a, std::uint64_t b) const
+    {
+        return a < b;
+    }
+    bool operator()(const DoubleKey& a, const DoubleKey& b) const
+    {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    }
+};
+
+struct KeyEqual
+{
+    bool operator()(std::uint64_t a, std::uint64_t b) const
+    {
+        return a == b;
+    }
+    bool operator()(const DoubleKey& a, const DoubleKey& b) const
+    {
+        return a.x == b.x && a.y == b.y;
+    }
+};
+
+// Top bits of a multiplicative hash; quantized coordinates share their high
+// bits, so the key itself would put everything into a few partitions.
+std::size_t partitionOf(std::uint64_t key)
+{
+    return static_cast<std::size_t>((key * 0x9e3779b97f4a7c15ull) >> (64 - PartitionBits));
+}
+
+std::size_t partitionOf(const DoubleKey& key)
+{
+    return partitionOf(key.x ^ (key.y * 0xc2b2ae3d27d4eb4full));
+}
+
+} // namespace
+
+std::size_t PointDeduplicator::run(const std::vector<PointI>& points, std::vector<PointI>& unique)
+{
+    return deduplicate(points, unique, m_integerKeys, m_integerScattered);
+}
+
+std::size_t PointDeduplicator::run(const std::vector<Point>& points, std::vector<Point>& unique)
+{
+    return deduplicate(points, unique, m_doubleKeys, m_doubleScattered);
+}
+
+std::size_t PointDeduplicator::scratchBytes() const
+{
+    return (m_integerKeys.capacity() + m_integerScattered.capacity()) * sizeof(std::uint64_t) +
+           (m_doubleKeys.capacity() + m_doubleScattered.capacity()) * sizeof(DoubleKey) +
+           (m_counts.capacity() + m_partitionStart.capacity() + m_uniqueCount.capacity()) * sizeof(std::size_t);
+}
+
+void PointDeduplicator::releaseScratch()
+{
+    std::vector<std::uint64_t>().swap(m_integerKeys);
+    std::vector<std::uint64_t>().swap(m_integerScattered);
+    std::vector<DoubleKey>().swap(m_doubleKeys);
+    std::vector<DoubleKey>().swap(m_doubleScattered);
+    std::vector<std::size_t>().swap(m_counts);
+    std::vector<std::size_t>().swap(m_partitionStart);
+    std::vector<std::size_t>().swap(m_uniqueCount);
+}
+
+template<typename T, typename Key>
+std::size_t PointDeduplicator::deduplicate(const std::vector<BasicPoint<T>>& points,
+                                           std::vector<BasicPoint<T>>& unique,
+                                           std::vector<Key>& keys, std::vector<Key>& scattered)
+{
+    const std::size_t n = points.size();
+
+    if (n < ParallelThreshold) {
+        keys.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            keys[i] = pack(points[i]);
+        }
+        std::sort(keys.begin(), keys.end(), KeyLess());
+        keys.erase(std::unique(keys.begin(), keys.end(), KeyEqual()), keys.end());
+
+        unique.resize(keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            unpack(keys[i], unique[i]);
+        }
+        return n - unique.size();
+    }
+
+    // Work is indexed by chunk rather than by the ranges parallelFor hands
+    // out, so the histogram and the scatter agree on every chunk's slots.
+    const std::size_t chunkCount = (n + ChunkSize - 1) / ChunkSize;
+    keys.resize(n);
+    m_counts.assign(chunkCount * PartitionCount, 0);
+
+    parallelFor(0, chunkCount, 1, [&](std::size_t firstChunk, std::size_t lastChunk) {
+        for (std::size_t chunk = firstChunk; chunk < lastChunk; ++chunk) {
+            std::size_t* p_counts = m_counts.data() + chunk * PartitionCount;
+            const std::size_t end = std::min(n, (chunk + 1) * ChunkSize);
+            for (std::size_t i = chunk * ChunkSize; i < end; ++i) {
+                keys[i] = pack(points[i]);
+                ++p_counts[partitionOf(keys[i])];
+            }
+        }
+    });
+
+    // Turn the counts into write positions: partitions back to back, and
+    // within a partition the chunks in order.
+    m_partitionStart.resize(PartitionCount + 1);
+    std::size_t offset = 0;
+    for (std::size_t partition = 0; partition < PartitionCount; ++partition) {
+        m_partitionStart[partition] = offset;
+        for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            std::size_t& count = m_counts[chunk * PartitionCount + partition];
+            const std::size_t size = count;
+            count = offset;
+            offset += size;
+        }
+    }
+    m_partitionStart[PartitionCount] = n;
+
+    scattered.resize(n);
+    parallelFor(0, chunkCount, 1, [&](std::size_t firstChunk, std::size_t lastChunk) {
+        for (std::size_t chunk = firstChunk; chunk < lastChunk; ++chunk) {
+            std::size_t* p_next = m_counts.data() + chunk * PartitionCount;
+            const std::size_t end = std::min(n, (chunk + 1) * ChunkSize);
+            for (std::size_t i = chunk * ChunkSize; i < end; ++i) {
+                scattered[p_next[partitionOf(keys[i])]++] = keys[i];
+            }
+        }
+    });
+
+    // Equal keys always share a partition, so each one is made unique alone.
+    m_uniqueCount.resize(PartitionCount + 1);
+    parallelFor(0, PartitionCount, 1, [&](std::size_t firstPartition, std::size_t lastPartition) {
+        for (std::size_t partition = firstPartition; partition < lastPartition; ++partition) {
+            const auto first = scattered.begin() + m_partitionStart[partition];
+            const auto last = scattered.begin() + m_partitionStart[partition + 1];
+            std::sort(first, last, KeyLess());
+            m_uniqueCount[partition] = std::unique(first, last, KeyEqual()) - first;
+        }
+    });
+
+    std::size_t uniqueTotal = 0;
+    for (std::size_t partition = 0; partition < PartitionCount; ++partition) {
+        const std::size_t count = m_uniqueCount[partition];
+        m_uniqueCount[partition] = uniqueTotal;
+        uniqueTotal += count;
+    }
+    m_uniqueCount[PartitionCount] = uniqueTotal;
+
+    unique.resize(uniqueTotal);
+    parallelFor(0, PartitionCount, 1, [&](std::size_t firstPartition, std::size_t lastPartition) {
+        for (std::size_t partition = firstPartition; partition < lastPartition; ++partition) {
+            const std::size_t size = m_uniqueCount[partition + 1] - m_uniqueCount[partition];
+            const Key* p_keys = scattered.data() + m_partitionStart[partition];
+            BasicPoint<T>* p_out = unique.data() + m_uniqueCount[partition];
+            for (std::size_t i = 0; i < size; ++i) {
+                unpack(p_keys[i], p_out[i]);
+            }
+        }
+    });
+
+    return n - uniqueTotal;
+}
@@ -0,0 +1,50 @@
+#ifndef POINTDEDUPLICATOR_H
+#define POINTDEDUPLICATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../geometry/Point.h"
+
+// Optional stage in front of the hull algorithms that drops repeated
+// points. Pixel and quantized inputs repeat heavily, and every copy costs a
+// slot in the O(n log n) sort and a tie in the comparators.
+//
+// Each point is packed into an integer key (both 32-bit coordinates in one
+// 64-bit word, or the bit patterns of both doubles). The keys are hashed
+// into partitions with a parallel counting scatter, and each partition is
+// then sorted and made unique on its own, so all passes run in parallel.
+// The unique points come out grouped by partition, not in input order.
+class PointDeduplicator
+{
+public:
+    // Returns the number of points removed. `unique` may be `points`.
+    std::size_t run(const std::vector<PointI>& points, std::vector<PointI>& unique);
+    std::size_t run(const std::vector<Point>& points, std::vector<Point>& unique);
+
+    std::size_t scratchBytes() const;
+    void releaseScratch();
+
+    struct DoubleKey
+    {
+        std::uint64_t x;
+        std::uint64_t y;
+    };
+
+private:
+    template<typename T, typename Key>
+    std::size_t deduplicate(const std::vector<BasicPoint<T>>& points, std::vector<BasicPoint<T>>& unique,
+                            std::vector<Key>& keys, std::vector<Key>& scattered);
+
+private:
+    std::vector<std::uint64_t> m_integerKeys;
+    std::vector<std::uint64_t> m_integerScattered;
+    std::vector<DoubleKey> m_doubleKeys;
+    std::vector<DoubleKey> m_doubleScattered;
+    std::vector<std::size_t> m_counts;
+    std::vector<std::size_t> m_partitionStart;
+    std::vector<std::size_t> m_uniqueCount;
+};
+
+#endif // POINTDEDUPLICATOR_H
@@ -1,46 +1,136 @@
 #include "AppState.h"
 #include "../algorithms/AndrewsAlgorithm.h"
+#include "../algorithms/AutoHull.h"
 #include "../algorithms/GrahamScan.h"
+#include "../geometry/PointConversion.h"
+
+#include <QThread>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr int DefaultFrameIntervalMs = 16;
+
+std::unique_ptr<ConvexHullAlgorithm> makeAlgorithm(AppState::AlgorithmType type)
+{
+    if (type == AppState::AlgorithmType::Andrew) {
+        return std::make_unique<AndrewsAlgorithm>();
+    }
+    if (type == AppState::AlgorithmType::Auto) {
+        return std::make_unique<AutoHull>();
+    }
+    return std::make_unique<GrahamScan>();
+}
+}
 
 AppState::AppState(QObject* parent)
     :   QObject(parent),
+    m_p_threadPool(std::make_unique<ThreadPool>()),
+    m_pointsRevision(0),
+    m_hullRevision(0),
+    m_hullQueryRevision(~quint64(0)),
+    m_deduplicate(false),
+    m_duplicatesRemoved(0),
+    m_showConvexLayers(false),
+    m_convexLayersRevision(0),
+    m_hullIsApproximate(false),
+    m_hullErrorBound(0.0),
+    m_p_refineThread(nullptr),
+    m_refinePending(false),
     m_algorithmType(AlgorithmType::Andrew),
+    m_inputMode(InputMode::Points),
     m_finished(false),
     m_currentStepIndex(0),
     m_isAnimating(false),
-    m_animationSpeedMs(500)
+    m_stepsPerSecond(2.0),
+    m_pendingSteps(0.0)
 {
+    ThreadPool::install(m_p_threadPool.get());
     createAlgorithm();
 
     m_animationTimer = new QTimer(this);
+    m_animationTimer->setTimerType(Qt::PreciseTimer);
+    m_animationTimer->setInterval(DefaultFrameIntervalMs);
     connect(m_animationTimer, &QTimer::timeout, this, &AppState::onTimerTick);
 }
 
-void AppState::createAlgorithm()
+AppState::~AppState()
 {
-    if (m_algorithmType == AlgorithmType::Andrew) {
-        m_p_algorithm = std::make_unique<AndrewsAlgorithm>();
-    }
-    else {
-        m_p_algorithm = std::make_unique<GrahamScan>();
+    // The deleteLater() in the finished handler never runs once this is
+    // being destroyed.
+    if (m_p_refineThread) {
+        m_p_refineThread->wait();
+        delete m_p_refineThread;
     }
+    ThreadPool::install(nullptr);
+}
+
+void AppState::createAlgorithm()
+{
+    m_p_algorithm = makeAlgorithm(m_algorithmType);
 }
 
 void AppState::addPoint(const Point& p)
 {
     m_points.push_back(p);
+    ++m_pointsRevision;
+    emit stateChanged();
+}
+
+void AppState::addPoints(const std::vector<Point>& points)
+{
+    m_points.insert(m_points.end(), points.begin(), points.end());
+    ++m_pointsRevision;
+    emit stateChanged();
+}
+
+// Appends `count` generated points directly into the point buffer.
+void AppState::generatePoints(const PointGenerator::Options& options, std::size_t count)
+{
+    const std::size_t first = m_points.size();
+    m_points.resize(first + count);
+    PointGenerator::generate(options, m_points.data() + first, count);
+    ++m_pointsRevision;
+    emit stateChanged();
+}
+
+// Points that move a little per frame leave the hull almost unchanged, so a
+// hull from step() is repaired by the kinetic hull. Animation traces describe
+// the old coordinates and are dropped.
+void AppState::movePoints(const std::vector<Point>& points)
+{
+    const bool sameSet = points.size() == m_points.size();
+    m_points.assign(points.begin(), points.end());
+    ++m_pointsRevision;
+
+    if (!sameSet || !m_finished || !m_animationSteps.empty()) {
+        resetAlgorithm();
+        return;
+    }
+
+    m_elapsedMs.start();
+    m_hull = m_kineticHull.update(m_points);
+    m_hullIsApproximate = false;
+    ++m_hullRevision;
     emit stateChanged();
 }
 
 void AppState::clear()
 {
     m_points.clear();
+    m_kineticHull.reset();
+    m_showConvexLayers = false;
+    ++m_pointsRevision;
     m_hull.clear();
+    m_hullIsApproximate = false;
+    ++m_hullRevision;
     m_animationSteps.clear();
     m_currentStepIndex = 0;
     m_finished = false;
     m_isAnimating = false;
     m_animationTimer->stop();
+    emit stepChanged(0, 0);
     emit stateChanged();
 }
 
@@ -56,14 +146,40 @@ AppState::AlgorithmType AppState::algorithm() const
     return m_algorithmType;
 }
 
+void AppState::setInputMode(InputMode mode)
+{
+    m_inputMode = mode;
+    resetAlgorithm();
+}
+
+AppState::InputMode AppState::inputMode() const
+{
+    return m_inputMode;
+}
+
+void AppState::setDeduplicate(bool enabled)
+{
+    m_deduplicate = enabled;
+    resetAlgorithm();
+}
+
+bool AppState::deduplicate() const
+{
+    return m_deduplicate;
+}
+
 void AppState::resetAlgorithm()
 {
+    m_showConvexLayers = false;
     m_hull.clear();
+    m_hullIsApproximate = false;
+    ++m_hullRevision;
     m_animationSteps.clear();
     m_currentStepIndex = 0;
     m_finished = false;
     m_isAnimating = false;
     m_animationTimer->stop();
+    emit stepChanged(0, 0);
     emit stateChanged();
 }
 
@@ -74,11 +190,127 @@ void AppState::step()
     }
 
     m_elapsedMs.start();
-    m_hull = m_p_algorithm->computeHull(m_points);
+
+    // Pixel-generated and quantized inputs take the exact integer kernel.
+    // All buffers are members so repeated recomputation does not allocate.
+    m_duplicatesRemoved = 0;
+    if (m_inputMode == InputMode::Polyline) {
+        if (toIntegerPoints(m_points, m_integerPoints)) {
+            m_melkman.computeHullInto(m_integerPoints, m_integerHull);
+            toPoints(m_integerHull, m_hull);
+        } else {
+            m_melkman.computeHullInto(m_points, m_hull);
+        }
+    } else if (toIntegerPoints(m_points, m_integerPoints)) {
+        if (m_deduplicate) {
+            m_duplicatesRemoved = m_deduplicator.run(m_integerPoints, m_integerPoints);
+        }
+        m_p_algorithm->computeHullInto(m_integerPoints, m_integerHull);
+        toPoints(m_integerHull, m_hull);
+    } else if (m_deduplicate) {
+        m_duplicatesRemoved = m_deduplicator.run(m_points, m_uniquePoints);
+        m_p_algorithm->computeHullInto(m_uniquePoints, m_hull);
+    } else {
+        m_p_algorithm->computeHullInto(m_points, m_hull);
+    }
+    m_hullIsApproximate = false;
+    ++m_hullRevision;
     m_finished = true;
     emit stateChanged();
 }
 
+void AppState::preview()
+{
+    if (m_finished || !m_p_algorithm || m_points.size() < 3) {
+        return;
+    }
+
+    m_elapsedMs.start();
+    m_approximateHull.compute(m_points, m_hull);
+    m_hullIsApproximate = true;
+    m_hullErrorBound = m_approximateHull.errorBound();
+    ++m_hullRevision;
+    m_finished = true;
+    emit stateChanged();
+
+    startRefinement();
+}
+
+void AppState::computeConvexLayers()
+{
+    m_elapsedMs.start();
+    m_convexLayers.compute(m_points);
+    m_showConvexLayers = true;
+    m_convexLayersRevision = m_pointsRevision;
+    emit stateChanged();
+}
+
+// Only points outside the approximation can be exact hull vertices, so the
+// worker gets a copy of those instead of the whole set. The result is tagged
+// with the hull revision and dropped if the hull changed in the meantime.
+void AppState::startRefinement()
+{
+    if (m_p_refineThread) {
+        m_refinePending = true;
+        return;
+    }
+
+    std::vector<Point> candidates;
+    m_approximateHull.collectCandidates(m_points, candidates);
+    const quint64 hullRevision = m_hullRevision;
+    const AlgorithmType type = m_algorithmType;
+
+    m_p_refineThread = QThread::create([this, hullRevision, type, candidates = std::move(candidates)]() {
+        std::unique_ptr<ConvexHullAlgorithm> p_algorithm = makeAlgorithm(type);
+        std::vector<Point> hull;
+        std::vector<PointI> integerPoints;
+        if (toIntegerPoints(candidates, integerPoints)) {
+            std::vector<PointI> integerHull;
+            p_algorithm->computeHullInto(integerPoints, integerHull);
+            toPoints(integerHull, hull);
+        } else {
+            p_algorithm->computeHullInto(candidates, hull);
+        }
+
+        QMetaObject::invokeMethod(this, [this, hullRevision, hull = std::move(hull)]() mutable {
+            applyRefinedHull(hullRevision, std::move(hull));
+        }, Qt::QueuedConnection);
+    });
+
+    connect(m_p_refineThread, &QThread::finished, this, [this]() {
+        m_p_refineThread->deleteLater();
+        m_p_refineThread = nullptr;
+
+        // A preview requested while the worker was busy. The approximation is
+        // rebuilt and shown again because the points may have changed since,
+        // and the candidates have to come from the hull on display.
+        if (m_refinePending) {
+            m_refinePending = false;
+            if (m_hullIsApproximate) {
+                m_approximateHull.compute(m_points, m_hull);
+                m_hullErrorBound = m_approximateHull.errorBound();
+                ++m_hullRevision;
+                emit stateChanged();
+                startRefinement();
+            }
+        }
+    });
+
+    m_p_refineThread->start();
+}
+
+void AppState::applyRefinedHull(quint64 hullRevision, std::vector<Point> hull)
+{
+    if (hullRevision != m_hullRevision || !m_hullIsApproximate) {
+        return;
+    }
+
+    m_hull = std::move(hull);
+    m_hullIsApproximate = false;
+    ++m_hullRevision;
+    emit stateChanged();
+}
+
 void AppState::generateAnimationSteps()
 {
     if (!m_p_algorithm || m_points.size() < 3) {
@@ -86,9 +318,20 @@ void AppState::generateAnimationSteps()
     }
 
     m_elapsedMs.start();
-    m_animationSteps = m_p_algorithm->generateSteps(m_points);
+    m_duplicatesRemoved = 0;
+    if (m_inputMode == InputMode::Polyline) {
+        m_animationSteps = m_melkman.generateSteps(m_points);
+    } else if (m_deduplicate) {
+        m_duplicatesRemoved = m_deduplicator.run(m_points, m_uniquePoints);
+        m_animationSteps = m_p_algorithm->generateSteps(m_uniquePoints);
+    } else {
+        m_animationSteps = m_p_algorithm->generateSteps(m_points);
+    }
     m_currentStepIndex = 0;
     m_hull.clear();
+    m_hullIsApproximate = false;
+    ++m_hullRevision;
+    emit stepChanged(m_currentStepIndex, totalSteps());
 }
 
 void AppState::startAnimation()
@@ -101,8 +344,14 @@ void AppState::startAnimation()
         generateAnimationSteps();
     }
 
+    if (m_currentStepIndex >= totalSteps()) {
+        seek(0);
+    }
+
     m_isAnimating = true;
-    m_animationTimer->start(m_animationSpeedMs);
+    m_pendingSteps = 0.0;
+    m_frameClock.start();
+    m_animationTimer->start();
     emit stateChanged();
 }
 
@@ -119,55 +368,79 @@ void AppState::stepForward()
         generateAnimationSteps();
     }
 
-    if (m_currentStepIndex < m_animationSteps.size()) {
-        m_currentStepIndex++;
-        applyCurrentStep();
-        emit stepChanged(m_currentStepIndex, m_animationSteps.size());
-        emit stateChanged();
-
-        if (m_currentStepIndex >= m_animationSteps.size()) {
-            m_finished = true;
-            m_isAnimating = false;
-            m_animationTimer->stop();
-        }
-    }
+    seek(m_currentStepIndex + 1);
 }
 
 void AppState::stepBackward()
 {
-    if (m_currentStepIndex > 0) {
-        m_currentStepIndex--;
-        applyCurrentStep();
-        emit stepChanged(m_currentStepIndex, m_animationSteps.size());
-        emit stateChanged();
+    seek(m_currentStepIndex - 1);
+}
+
+// Jumps straight to a step. Every AnimationStep carries a full snapshot of the
+// hull, so the cost only depends on the size of that snapshot and not on how
+// far the index moves.
+void AppState::seek(int stepIndex)
+{
+    const int total = totalSteps();
+    stepIndex = std::clamp(stepIndex, 0, total);
 
-        m_finished = false;
+    if (stepIndex == m_currentStepIndex) {
+        return;
     }
+
+    m_currentStepIndex = stepIndex;
+    applyCurrentStep();
+    m_finished = total > 0 && m_currentStepIndex >= total;
+
+    if (m_finished && m_isAnimating) {
+        m_isAnimating = false;
+        m_animationTimer->stop();
+    }
+
+    emit stepChanged(m_currentStepIndex, total);
+    emit stateChanged();
 }
 
-void AppState::setAnimationSpeed(int speedMs)
+void AppState::setPlaybackRate(double stepsPerSecond)
 {
-    m_animationSpeedMs = speedMs;
-    if (m_isAnimating) {
-        m_animationTimer->setInterval(speedMs);
-    }
+    m_stepsPerSecond = std::max(stepsPerSecond, 0.0);
+}
+
+void AppState::setFrameInterval(int intervalMs)
+{
+    m_animationTimer->setInterval(std::max(intervalMs, 1));
 }
 
+// One tick per display frame: all steps that became due since the previous
+// frame are coalesced into a single seek, so the view repaints once per frame
+// no matter how high the playback rate is.
 void AppState::onTimerTick()
 {
-    stepForward();
+    const double elapsedSeconds = m_frameClock.restart() / 1000.0;
+    m_pendingSteps += elapsedSeconds * m_stepsPerSecond;
+
+    const double dueSteps = std::floor(m_pendingSteps);
+    if (dueSteps < 1.0) {
+        return;
+    }
+    m_pendingSteps -= dueSteps;
+
+    const double target = std::min<double>(m_currentStepIndex + dueSteps, totalSteps());
+    seek(static_cast<int>(target));
 }
 
 void AppState::applyCurrentStep()
 {
     if (m_currentStepIndex == 0) {
         m_hull.clear();
+        ++m_hullRevision;
         return;
     }
 
     if (m_currentStepIndex > 0 && m_currentStepIndex <= m_animationSteps.size()) {
         const AnimationStep& step = m_animationSteps[m_currentStepIndex - 1];
         m_hull = step.currentHull;
+        ++m_hullRevision;
     }
 }
 
@@ -176,11 +449,26 @@ const std::vector<Point>& AppState::points() const
     return m_points;
 }
 
+quint64 AppState::pointsRevision() const
+{
+    return m_pointsRevision;
+}
+
 const std::vector<Point>& AppState::hull() const
 {
     return m_hull;
 }
 
+// Built on first use after the hull changed, so playback does not pay for it.
+const HullQuery& AppState::hullQuery() const
+{
+    if (m_hullQueryRevision != m_hullRevision) {
+        m_hullQuery.build(m_hull);
+        m_hullQueryRevision = m_hullRevision;
+    }
+    return m_hullQuery;
+}
+
 const AnimationStep* AppState::currentStep() const
 {
     if (m_currentStepIndex > 0 && m_currentStepIndex <= m_animationSteps.size()) {
@@ -209,6 +497,49 @@ bool AppState::finished() const
     return m_finished;
 }
 
+bool AppState::hullIsApproximate() const
+{
+    return m_hullIsApproximate;
+}
+
+std::size_t AppState::duplicatesRemoved() const
+{
+    return m_duplicatesRemoved;
+}
+
+void AppState::setThreadPoolOptions(const ThreadPool::Options& options)
+{
+    if (m_p_refineThread) {
+        m_p_refineThread->wait();
+    }
+    ThreadPool::install(nullptr);
+    m_p_threadPool = std::make_unique<ThreadPool>(options);
+    ThreadPool::install(m_p_threadPool.get());
+}
+
+const ThreadPool::Options& AppState::threadPoolOptions() const
+{
+    return m_p_threadPool->options();
+}
+
+std::vector<ThreadPool::WorkerStats> AppState::threadPoolStats() const
+{
+    return m_p_threadPool->stats();
+}
+
+double AppState::hullErrorBound() const
+{
+    return m_hullErrorBound;
+}
+
+const ConvexLayers* AppState::convexLayers() const
+{
+    if (!m_showConvexLayers || m_convexLayersRevision != m_pointsRevision) {
+        return nullptr;
+    }
+    return &m_convexLayers;
+}
+
 double AppState::elapsedTimeMs() const
 {
     return m_elapsedMs.nsecsElapsed() / 1e9;
@@ -216,5 +547,18 @@ double AppState::elapsedTimeMs() const
 
 QString AppState::algorithmName() const
 {
+    if (m_inputMode == InputMode::Polyline) {
+        return m_melkman.name();
+    }
     return m_p_algorithm ? m_p_algorithm->name() : "None";
 }
+
+QString AppState::algorithmDecision() const
+{
+    if (m_algorithmType != AlgorithmType::Auto || m_inputMode != InputMode::Points ||
+        !m_finished || m_hullIsApproximate) {
+        return QString();
+    }
+    const AutoHull::Decision& decision = static_cast<const AutoHull*>(m_p_algorithm.get())->lastDecision();
+    return decision.profile.count > 0 ? AutoHull::describe(decision) : QString();
+}
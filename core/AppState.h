@@ -7,8 +7,18 @@
 #include <vector>
 #include <memory>
 
+class QThread;
+
 #include "../geometry/Point.h"
+#include "../algorithms/ApproximateHull.h"
 #include "../algorithms/ConvexHullAlgorithm.h"
+#include "../algorithms/ConvexLayers.h"
+#include "../algorithms/KineticHull.h"
+#include "../algorithms/MelkmanHull.h"
+#include "../algorithms/PointDeduplicator.h"
+#include "PointGenerator.h"
+#include "ThreadPool.h"
+#include "../geometry/HullQuery.h"
 
 class AppState : public QObject
 {
@@ -17,24 +27,53 @@ class AppState : public QObject
 public:
     enum class AlgorithmType {
         Andrew,
-        Graham
+        Graham,
+        // Chooses a strategy per input; see AutoHull.
+        Auto
+    };
+
+    enum class InputMode {
+        Points,
+        // The points in the order they were added form a simple polyline,
+        // such as a track or a contour. Its hull is computed by MelkmanHull
+        // in linear time, whatever algorithm is selected.
+        Polyline
     };
 
     explicit AppState(QObject* parent = nullptr);
+    ~AppState() override;
 
     void addPoint(const Point& p);
+    void addPoints(const std::vector<Point>& points);
+    void generatePoints(const PointGenerator::Options& options, std::size_t count);
+    // New coordinates for the existing points, in the same order. A computed
+    // hull is kept current incrementally instead of being recomputed.
+    void movePoints(const std::vector<Point>& points);
     void clear();
 
     void setAlgorithm(AlgorithmType type);
     AlgorithmType algorithm() const;
+    void setInputMode(InputMode mode);
+    InputMode inputMode() const;
+    // Drops repeated points before the algorithm runs; the hull is the same.
+    // Ignored for polylines, whose order it would lose.
+    void setDeduplicate(bool enabled);
+    bool deduplicate() const;
     void resetAlgorithm();
     void step();
+    // Shows an approximate hull at once and replaces it with the exact one
+    // when a background computation finishes.
+    void preview();
+    // Peels all convex layers of the current points for display.
+    void computeConvexLayers();
 
     void startAnimation();
     void pauseAnimation();
     void stepForward();
     void stepBackward();
-    void setAnimationSpeed(int speedMs);
+    void seek(int stepIndex);
+    void setPlaybackRate(double stepsPerSecond);
+    void setFrameInterval(int intervalMs);
 
     const AnimationStep* currentStep() const;
     int currentStepIndex() const;
@@ -42,11 +81,27 @@ public:
     bool isAnimating() const;
 
     const std::vector<Point>& points() const;
+    quint64 pointsRevision() const;
     const std::vector<Point>& hull() const;
+    const HullQuery& hullQuery() const;
     bool finished() const;
+    bool hullIsApproximate() const;
+    double hullErrorBound() const;
+    // Points the dedup stage removed for the current hull or trace.
+    std::size_t duplicatesRemoved() const;
+
+    // The state owns the process-wide thread pool; replacing it waits for
+    // background work first.
+    void setThreadPoolOptions(const ThreadPool::Options& options);
+    const ThreadPool::Options& threadPoolOptions() const;
+    std::vector<ThreadPool::WorkerStats> threadPoolStats() const;
+    // Null unless computeConvexLayers() ran on the current points.
+    const ConvexLayers* convexLayers() const;
 
     double elapsedTimeMs() const;
     QString algorithmName() const;
+    // What Auto chose for the current hull; empty for the other algorithms.
+    QString algorithmDecision() const;
 
 signals:
     void stateChanged();
@@ -59,13 +114,39 @@ private:
     void createAlgorithm();
     void generateAnimationSteps();
     void applyCurrentStep();
+    void startRefinement();
+    void applyRefinedHull(quint64 hullRevision, std::vector<Point> hull);
 
 private:
+    // First, so it outlives everything that may run parallel work.
+    std::unique_ptr<ThreadPool> m_p_threadPool;
+
     std::vector<Point> m_points;
+    quint64 m_pointsRevision;
     std::vector<Point> m_hull;
+    quint64 m_hullRevision;
+    mutable HullQuery m_hullQuery;
+    mutable quint64 m_hullQueryRevision;
+    std::vector<PointI> m_integerPoints;
+    std::vector<PointI> m_integerHull;
+    PointDeduplicator m_deduplicator;
+    std::vector<Point> m_uniquePoints;
+    bool m_deduplicate;
+    std::size_t m_duplicatesRemoved;
+    KineticHull m_kineticHull;
+    ConvexLayers m_convexLayers;
+    bool m_showConvexLayers;
+    quint64 m_convexLayersRevision;
+    ApproximateHull m_approximateHull;
+    bool m_hullIsApproximate;
+    double m_hullErrorBound;
+    QThread* m_p_refineThread;
+    bool m_refinePending;
 
     AlgorithmType m_algorithmType;
     std::unique_ptr<ConvexHullAlgorithm> m_p_algorithm;
+    InputMode m_inputMode;
+    MelkmanHull m_melkman;
 
     bool m_finished;
     QElapsedTimer m_elapsedMs;
@@ -74,7 +155,9 @@ private:
     int m_currentStepIndex;
     bool m_isAnimating;
     QTimer* m_animationTimer;
-    int m_animationSpeedMs;
+    QElapsedTimer m_frameClock;
+    double m_stepsPerSecond;
+    double m_pendingSteps;
 };
 
 #endif // APPSTATE_H
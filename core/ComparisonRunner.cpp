@@ -0,0 +1,118 @@
+#include "ComparisonRunner.h"
+#include "Parallel.h"
+#include "../algorithms/AlgorithmRegistry.h"
+#include "../geometry/Orientation.h"
+#include "../geometry/PointConversion.h"
+
+#include <QThread>
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+// Rotates a hull so that it starts at its lexicographically smallest vertex,
+// which makes hulls from different algorithms directly comparable.
+std::vector<Point> canonicalHull(std::vector<Point> hull)
+{
+    const auto first = std::min_element(hull.begin(), hull.end(), [](const Point& a, const Point& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    std::rotate(hull.begin(), first, hull.end());
+    return hull;
+}
+
+bool sameHull(const std::vector<Point>& a, const std::vector<Point>& b)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const Point& p, const Point& q) {
+        return p.x == q.x && p.y == q.y;
+    });
+}
+
+} // namespace
+
+ComparisonRunner::ComparisonRunner(QObject* parent)
+    :   QObject(parent), m_p_thread(nullptr)
+{
+}
+
+ComparisonRunner::~ComparisonRunner()
+{
+    // The finished handler that would deleteLater() the thread is
+    // disconnected along with this object.
+    if (m_p_thread) {
+        m_p_thread->wait();
+        delete m_p_thread;
+    }
+}
+
+bool ComparisonRunner::isRunning() const
+{
+    return m_p_thread != nullptr;
+}
+
+void ComparisonRunner::start(std::vector<Point> points)
+{
+    if (m_p_thread) {
+        return;
+    }
+
+    m_p_thread = QThread::create([this, points = std::move(points)]() {
+        std::vector<ComparisonResult> results = run(points);
+        QMetaObject::invokeMethod(this, [this, results = std::move(results)]() {
+            emit finished(results);
+        }, Qt::QueuedConnection);
+    });
+
+    connect(m_p_thread, &QThread::finished, this, [this]() {
+        m_p_thread->deleteLater();
+        m_p_thread = nullptr;
+    });
+
+    m_p_thread->start();
+}
+
+std::vector<ComparisonResult> ComparisonRunner::run(const std::vector<Point>& points)
+{
+    const std::vector<AlgorithmInfo>& algorithms = AlgorithmRegistry::algorithms();
+
+    std::vector<PointI> integerPoints;
+    const bool integral = toIntegerPoints(points, integerPoints);
+
+    std::vector<ComparisonResult> results(algorithms.size());
+    std::vector<std::vector<Point>> hulls(algorithms.size());
+
+    // One task per algorithm; orientationTestCount is per thread, so each
+    // task counts exactly its own predicates.
+    parallelFor(0, algorithms.size(), 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            std::unique_ptr<ConvexHullAlgorithm> algorithm = algorithms[i].create();
+            ComparisonResult& result = results[i];
+            result.name = algorithms[i].name;
+
+            orientationTestCount = 0;
+            const auto start = std::chrono::steady_clock::now();
+
+            if (integral) {
+                std::vector<PointI> hull;
+                algorithm->computeHullInto(integerPoints, hull);
+                toPoints(hull, hulls[i]);
+            } else {
+                algorithm->computeHullInto(points, hulls[i]);
+            }
+
+            const auto end = std::chrono::steady_clock::now();
+            result.milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+            result.orientationTests = orientationTestCount;
+            result.scratchBytes = algorithm->scratchBytes();
+            result.hullSize = hulls[i].size();
+        }
+    });
+
+    for (std::size_t i = 0; i < hulls.size(); ++i) {
+        hulls[i] = canonicalHull(std::move(hulls[i]));
+        results[i].matchesReference = sameHull(hulls[i], hulls[0]);
+    }
+
+    return results;
+}
@@ -0,0 +1,47 @@
+#ifndef COMPARISONRUNNER_H
+#define COMPARISONRUNNER_H
+
+#include <QObject>
+#include <QString>
+#include <vector>
+
+#include "../geometry/Point.h"
+
+class QThread;
+
+struct ComparisonResult
+{
+    QString name;
+    double milliseconds = 0.0;
+    quint64 orientationTests = 0;
+    std::size_t scratchBytes = 0;
+    std::size_t hullSize = 0;
+    // Same vertex cycle as the first registered algorithm.
+    bool matchesReference = false;
+};
+
+// Runs every algorithm of the AlgorithmRegistry on the same points, all at
+// once and off the GUI thread, and cross-checks the hulls they produce.
+class ComparisonRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ComparisonRunner(QObject* parent = nullptr);
+    ~ComparisonRunner() override;
+
+    bool isRunning() const;
+    // Ignored while a comparison is still running.
+    void start(std::vector<Point> points);
+
+    // Synchronous form used by the background thread.
+    static std::vector<ComparisonResult> run(const std::vector<Point>& points);
+
+signals:
+    void finished(const std::vector<ComparisonResult>& results);
+
+private:
+    QThread* m_p_thread;
+};
+
+#endif // COMPARISONRUNNER_H
@@ -0,0 +1,32 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstddef>
+#include <utility>
+
+#include "ThreadPool.h"
+
+// Shorthands for the global ThreadPool, which every parallel stage shares.
+
+inline unsigned parallelWorkerCount()
+{
+    return ThreadPool::global().concurrency();
+}
+
+// Splits [begin, end) into chunks of at least `grain` elements and calls
+// fn(chunkBegin, chunkEnd) for each of them on up to parallelWorkerCount()
+// threads, the calling thread included. Returns once every chunk is done.
+template<typename Fn>
+void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Fn&& fn)
+{
+    ThreadPool::global().parallelFor(begin, end, grain, std::forward<Fn>(fn));
+}
+
+template<typename T, typename Map, typename Combine>
+T parallelReduce(std::size_t begin, std::size_t end, std::size_t grain, T identity, Map&& map, Combine&& combine)
+{
+    return ThreadPool::global().parallelReduce(begin, end, grain, std::move(identity),
+                                               std::forward<Map>(map), std::forward<Combine>(combine));
+}
+
+#endif // PARALLEL_H
@@ -0,0 +1,236 @@
+#include "PointGenerator.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr std::size_t ChunkSize = 1 << 14;
+constexpr double Pi = 3.14159265358979323846;
+
+class SplitMix64
+{
+public:
+    explicit SplitMix64(std::uint64_t seed) : m_state(seed) {}
+
+    std::uint64_t next()
+    {
+        std::uint64_t z = (m_state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, 1).
+    double uniform()
+    {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+
+    std::uint64_t bounded(std::uint64_t range)
+    {
+        return next() % range;
+    }
+
+    double gaussian()
+    {
+        const double u = 1.0 - uniform();
+        const double v = uniform();
+        return std::sqrt(-2.0 * std::log(u)) * std::cos(2.0 * Pi * v);
+    }
+
+private:
+    std::uint64_t m_state;
+};
+
+std::uint64_t chunkSeed(std::uint64_t seed, std::uint64_t chunk)
+{
+    SplitMix64 mixer(seed ^ (chunk * 0xD1B54A32D192ED03ull));
+    return mixer.next();
+}
+
+// Values derived from the options once and shared by all chunks.
+struct Layout {
+    double width;
+    double height;
+    double centerX;
+    double centerY;
+    double radius;
+    std::vector<Point> clusterCenters;
+    double clusterSigma;
+    Point anchors[8];
+    double contourPhases[2];
+};
+
+Layout makeLayout(const PointGenerator::Options& options)
+{
+    Layout layout;
+    layout.width = options.maxX - options.minX;
+    layout.height = options.maxY - options.minY;
+    layout.centerX = options.minX + layout.width / 2.0;
+    layout.centerY = options.minY + layout.height / 2.0;
+    layout.radius = std::min(layout.width, layout.height) / 2.0;
+    layout.clusterSigma = 0.05 * std::min(layout.width, layout.height);
+
+    // Cluster centers come from their own stream so that they do not depend
+    // on how many points are requested.
+    SplitMix64 rng(chunkSeed(options.seed, ~0ull));
+    const int clusterCount = std::max(options.clusterCount, 1);
+    for (int i = 0; i < clusterCount; ++i) {
+        layout.clusterCenters.emplace_back(
+            options.minX + layout.width * (0.1 + 0.8 * rng.uniform()),
+            options.minY + layout.height * (0.1 + 0.8 * rng.uniform()));
+    }
+
+    layout.contourPhases[0] = 2.0 * Pi * rng.uniform();
+    layout.contourPhases[1] = 2.0 * Pi * rng.uniform();
+
+    const double midX = layout.centerX;
+    const double midY = layout.centerY;
+    const Point anchors[8] = {
+        {options.minX, options.minY}, {midX, options.minY},
+        {options.maxX, options.minY}, {options.maxX, midY},
+        {options.maxX, options.maxY}, {midX, options.maxY},
+        {options.minX, options.maxY}, {options.minX, midY}
+    };
+    std::copy(std::begin(anchors), std::end(anchors), layout.anchors);
+
+    return layout;
+}
+
+Point onCircle(const Layout& layout, double radius, double angle)
+{
+    return Point(layout.centerX + radius * std::cos(angle),
+                 layout.centerY + radius * std::sin(angle));
+}
+
+// Point `index` of `count`; only the contour depends on the position.
+Point generatePoint(const PointGenerator::Options& options, const Layout& layout, SplitMix64& rng,
+                    std::size_t index, std::size_t count)
+{
+    using Distribution = PointGenerator::Distribution;
+
+    switch (options.distribution) {
+    case Distribution::Uniform:
+        return Point(options.minX + layout.width * rng.uniform(),
+                     options.minY + layout.height * rng.uniform());
+
+    case Distribution::Disk:
+        return onCircle(layout, layout.radius * std::sqrt(rng.uniform()), 2.0 * Pi * rng.uniform());
+
+    case Distribution::Circle:
+        return onCircle(layout, layout.radius, 2.0 * Pi * rng.uniform());
+
+    case Distribution::GaussianClusters: {
+        const Point& center = layout.clusterCenters[rng.bounded(layout.clusterCenters.size())];
+        const double x = center.x + layout.clusterSigma * rng.gaussian();
+        const double y = center.y + layout.clusterSigma * rng.gaussian();
+        return Point(std::clamp(x, options.minX, options.maxX),
+                     std::clamp(y, options.minY, options.maxY));
+    }
+
+    case Distribution::Collinear: {
+        // Diagonal of the centered square. Integral offsets are added to both
+        // coordinates so the points stay exactly collinear after rounding.
+        const double side = 2.0 * layout.radius;
+        double offset = side * rng.uniform();
+        if (options.integral) {
+            offset = std::floor(offset);
+        }
+        return Point(layout.centerX - layout.radius + offset,
+                     layout.centerY - layout.radius + offset);
+    }
+
+    case Distribution::Adversarial:
+        // Exact duplicates, points on the bounding box edges (collinear with
+        // hull edges) and cocircular points: the tie paths of every algorithm.
+        switch (rng.bounded(3)) {
+        case 0:
+            return layout.anchors[rng.bounded(8)];
+        case 1: {
+            const double t = rng.uniform();
+            switch (rng.bounded(4)) {
+            case 0: return Point(options.minX + t * layout.width, options.minY);
+            case 1: return Point(options.maxX, options.minY + t * layout.height);
+            case 2: return Point(options.minX + t * layout.width, options.maxY);
+            default: return Point(options.minX, options.minY + t * layout.height);
+            }
+        }
+        default:
+            return onCircle(layout, layout.radius, 2.0 * Pi * rng.uniform());
+        }
+
+    case Distribution::Contour: {
+        // Star-shaped around the center with the angle growing along the
+        // points, so the polyline never crosses itself; two slow waves make
+        // the radius wander. No per-point noise: rounded to pixels, noisy
+        // neighbours would zigzag across each other.
+        const double angle = 2.0 * Pi * static_cast<double>(index) / static_cast<double>(count);
+        const double wave = 0.2 * std::sin(3.0 * angle + layout.contourPhases[0]) +
+                            0.1 * std::sin(7.0 * angle + layout.contourPhases[1]);
+        return onCircle(layout, layout.radius * (0.6 + wave), angle);
+    }
+    }
+
+    return Point();
+}
+
+} // namespace
+
+void PointGenerator::generate(const Options& options, Point* out, std::size_t count)
+{
+    const Layout layout = makeLayout(options);
+    const std::size_t chunkCount = (count + ChunkSize - 1) / ChunkSize;
+
+    parallelFor(0, chunkCount, 1, [&](std::size_t firstChunk, std::size_t lastChunk) {
+        for (std::size_t chunk = firstChunk; chunk < lastChunk; ++chunk) {
+            SplitMix64 rng(chunkSeed(options.seed, chunk));
+
+            const std::size_t begin = chunk * ChunkSize;
+            const std::size_t end = std::min(begin + ChunkSize, count);
+            for (std::size_t i = begin; i < end; ++i) {
+                Point p = generatePoint(options, layout, rng, i, count);
+                if (options.integral) {
+                    p.x = std::floor(p.x);
+                    p.y = std::floor(p.y);
+                }
+                out[i] = p;
+            }
+        }
+    });
+}
+
+std::vector<Point> PointGenerator::generate(const Options& options, std::size_t count)
+{
+    std::vector<Point> points(count);
+    generate(options, points.data(), count);
+    return points;
+}
+
+const char* PointGenerator::name(Distribution distribution)
+{
+    switch (distribution) {
+    case Distribution::Uniform:          return "Uniform";
+    case Distribution::Disk:             return "Disk";
+    case Distribution::Circle:           return "Circle";
+    case Distribution::GaussianClusters: return "Gaussian clusters";
+    case Distribution::Collinear:        return "Collinear";
+    case Distribution::Adversarial:      return "Adversarial";
+    case Distribution::Contour:          return "Contour";
+    }
+    return "Unknown";
+}
+
+std::vector<PointGenerator::Distribution> PointGenerator::distributions()
+{
+    return {
+        Distribution::Uniform,
+        Distribution::Disk,
+        Distribution::Circle,
+        Distribution::GaussianClusters,
+        Distribution::Collinear,
+        Distribution::Adversarial,
+        Distribution::Contour
+    };
+}
@@ -0,0 +1,47 @@
+#ifndef POINTGENERATOR_H
+#define POINTGENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../geometry/Point.h"
+
+// Bulk point generation for the GUI and the benchmarks. The output is split
+// into fixed-size chunks, each with its own generator seeded from
+// (seed, chunk index), so the chunks can be filled in parallel and the same
+// seed always yields the same dataset regardless of the thread count.
+class PointGenerator
+{
+public:
+    enum class Distribution {
+        Uniform,
+        Disk,
+        Circle,
+        GaussianClusters,
+        Collinear,
+        Adversarial,
+        // A closed contour traced in order, a simple polyline for Melkman.
+        Contour
+    };
+
+    struct Options {
+        Distribution distribution = Distribution::Uniform;
+        std::uint64_t seed = 0;
+        double minX = 0.0;
+        double minY = 0.0;
+        double maxX = 1.0;
+        double maxY = 1.0;
+        // Round coordinates down to integers, like pixel positions.
+        bool integral = false;
+        int clusterCount = 8;
+    };
+
+    static void generate(const Options& options, Point* out, std::size_t count);
+    static std::vector<Point> generate(const Options& options, std::size_t count);
+
+    static const char* name(Distribution distribution);
+    static std::vector<Distribution> distributions();
+};
+
+#endif // POINTGENERATOR_H
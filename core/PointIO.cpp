@@ -0,0 +1,284 @@
+#include "PointIO.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+
+#if !defined(__cpp_lib_to_chars)
+#include <locale>
+#include <sstream>
+#endif
+
+namespace {
+
+// Chunks smaller than this are not worth a thread of their own.
+constexpr std::size_t MinChunkBytes = 1 << 20;
+
+// Powers of ten that are exact in a double.
+constexpr double ExactPowersOfTen[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+inline bool isDigit(char c)
+{
+    return static_cast<unsigned char>(c - '0') < 10;
+}
+
+inline bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Correctly rounded conversion for the inputs the fast path cannot handle
+// exactly: more than 19 significant digits or large exponents.
+bool parseNumberSlow(const char* begin, const char* end, double& value)
+{
+#if defined(__cpp_lib_to_chars)
+    if (*begin == '+') {
+        ++begin;
+    }
+    return std::from_chars(begin, end, value).ec == std::errc();
+#else
+    std::istringstream stream(std::string(begin, end));
+    stream.imbue(std::locale::classic());
+    stream >> value;
+    return !stream.fail();
+#endif
+}
+
+// Reads a decimal number such as -12, 3.25 or 1e-3 starting at `p`. Returns
+// the position after it, or nullptr if there is none. A mantissa of at most
+// 2^53 with a power of ten up to 22 is converted with one exact multiply or
+// divide, which is correctly rounded; everything else is handed on to
+// parseNumberSlow.
+const char* parseNumber(const char* p, const char* end, double& value)
+{
+    const char* const start = p;
+
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+
+    std::uint64_t mantissa = 0;
+    int significantDigits = 0;
+    int exponent = 0;
+    bool truncated = false;
+    bool anyDigit = false;
+
+    for (; p != end && isDigit(*p); ++p) {
+        anyDigit = true;
+        if (significantDigits < 19) {
+            mantissa = mantissa * 10 + (*p - '0');
+            significantDigits += mantissa != 0;
+        } else {
+            ++exponent;
+            truncated = true;
+        }
+    }
+
+    if (p != end && *p == '.') {
+        for (++p; p != end && isDigit(*p); ++p) {
+            anyDigit = true;
+            if (significantDigits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                significantDigits += mantissa != 0;
+                --exponent;
+            } else {
+                truncated = true;
+            }
+        }
+    }
+
+    if (!anyDigit) {
+        return nullptr;
+    }
+
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        bool negativeExponent = false;
+        if (q != end && (*q == '-' || *q == '+')) {
+            negativeExponent = *q == '-';
+            ++q;
+        }
+        if (q != end && isDigit(*q)) {
+            int written = 0;
+            for (; q != end && isDigit(*q); ++q) {
+                written = std::min(written * 10 + (*q - '0'), 100000);
+            }
+            exponent += negativeExponent ? -written : written;
+            p = q;
+        }
+    }
+
+    if (mantissa == 0) {
+        value = negative ? -0.0 : 0.0;
+        return p;
+    }
+
+    if (!truncated && mantissa <= (std::uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+        const double m = static_cast<double>(mantissa);
+        value = exponent < 0 ? m / ExactPowersOfTen[-exponent] : m * ExactPowersOfTen[exponent];
+        value = negative ? -value : value;
+        return p;
+    }
+
+    return parseNumberSlow(start, p, value) ? p : nullptr;
+}
+
+// Lines are scanned once: numbers stop at the newline on their own, and
+// only the rest of a line after the two values is searched for it.
+PointIO::ParseStats parseLines(const char* p, const char* end, std::vector<Point>& out)
+{
+    PointIO::ParseStats stats;
+
+    while (p != end) {
+        while (p != end && isBlank(*p)) {
+            ++p;
+        }
+        if (p == end) {
+            break;
+        }
+        if (*p == '\n') {
+            ++p;
+            continue;
+        }
+
+        const char* q = nullptr;
+        if (*p != '#') {
+            ++stats.lines;
+
+            Point point;
+            q = parseNumber(p, end, point.x);
+            if (q) {
+                while (q != end && isBlank(*q)) {
+                    ++q;
+                }
+                if (q != end && (*q == ',' || *q == ';')) {
+                    ++q;
+                }
+                while (q != end && isBlank(*q)) {
+                    ++q;
+                }
+                q = parseNumber(q, end, point.y);
+            }
+
+            if (q) {
+                out.push_back(point);
+                p = q;
+            } else {
+                ++stats.invalidLines;
+            }
+        }
+
+        if (p != end && *p == '\n') {
+            ++p;
+        } else {
+            const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            p = newline ? newline + 1 : end;
+        }
+    }
+
+    return stats;
+}
+
+// Writes a value with '.' as decimal separator and enough digits to read it
+// back exactly.
+char* formatNumber(char* out, char* end, double value)
+{
+#if defined(__cpp_lib_to_chars)
+    return std::to_chars(out, end, value).ptr;
+#else
+    std::ostringstream stream;
+    stream.imbue(std::locale::classic());
+    stream.precision(17);
+    stream << value;
+    const std::string text = stream.str();
+    std::memcpy(out, text.data(), std::min<std::size_t>(text.size(), end - out));
+    return out + std::min<std::size_t>(text.size(), end - out);
+#endif
+}
+
+} // namespace
+
+PointIO::ParseStats PointIO::parse(const char* begin, const char* end, std::vector<Point>& out,
+                                   unsigned threadCount)
+{
+    const std::size_t bytes = end - begin;
+    const std::size_t chunkCount = std::max<std::size_t>(
+        1, std::min<std::size_t>(threadCount, bytes / MinChunkBytes));
+
+    if (chunkCount == 1) {
+        return parseLines(begin, end, out);
+    }
+
+    // Chunk boundaries move forward to the next line start, so every line is
+    // parsed by exactly one chunk.
+    std::vector<const char*> boundaries(chunkCount + 1, end);
+    boundaries[0] = begin;
+    for (std::size_t i = 1; i < chunkCount; ++i) {
+        const char* p = std::max(begin + bytes * i / chunkCount, boundaries[i - 1]);
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        boundaries[i] = newline ? newline + 1 : end;
+    }
+
+    std::vector<std::vector<Point>> parts(chunkCount);
+    std::vector<ParseStats> partStats(chunkCount);
+    parallelFor(0, chunkCount, 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            parts[i].reserve((boundaries[i + 1] - boundaries[i]) / 16);
+            partStats[i] = parseLines(boundaries[i], boundaries[i + 1], parts[i]);
+        }
+    });
+
+    ParseStats stats;
+    std::size_t total = out.size();
+    for (std::size_t i = 0; i < chunkCount; ++i) {
+        total += parts[i].size();
+        stats.lines += partStats[i].lines;
+        stats.invalidLines += partStats[i].invalidLines;
+    }
+    out.reserve(total);
+    for (const std::vector<Point>& part : parts) {
+        out.insert(out.end(), part.begin(), part.end());
+    }
+    return stats;
+}
+
+void PointIO::format(const std::vector<Point>& points, char separator, std::string& out)
+{
+    // Two shortest round-trip doubles, a separator and a newline.
+    constexpr std::size_t MaxLineLength = 2 * 32 + 2;
+
+    const std::size_t first = out.size();
+    out.resize(first + points.size() * MaxLineLength);
+
+    char* p = &out[0] + first;
+    char* const end = &out[0] + out.size();
+    for (const Point& point : points) {
+        p = formatNumber(p, end, point.x);
+        *p++ = separator;
+        p = formatNumber(p, end, point.y);
+        *p++ = '\n';
+    }
+    out.resize(p - &out[0]);
+}
+
+bool PointIO::readAll(std::FILE* file, std::vector<char>& out)
+{
+    constexpr std::size_t BlockSize = 1 << 20;
+
+    for (;;) {
+        const std::size_t size = out.size();
+        out.resize(size + BlockSize);
+        const std::size_t read = std::fread(out.data() + size, 1, BlockSize, file);
+        out.resize(size + read);
+        if (read < BlockSize) {
+            return !std::ferror(file);
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef POINTIO_H
+#define POINTIO_H
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../geometry/Point.h"
+
+// Text input and output for the command-line mode. One point per line as two
+// numbers separated by whitespace, a comma or a semicolon; further columns
+// are ignored. Empty lines and lines starting with '#' are skipped, any other
+// line without two numbers (such as a CSV header) is counted as invalid.
+//
+// Numbers are always read and written with '.' as the decimal separator,
+// independent of the C locale, and parsing does not allocate per line.
+class PointIO
+{
+public:
+    struct ParseStats {
+        std::size_t lines = 0;
+        std::size_t invalidLines = 0;
+    };
+
+    // Appends the parsed points to `out` in input order. With more than one
+    // thread the text is split into chunks at line boundaries.
+    static ParseStats parse(const char* begin, const char* end, std::vector<Point>& out,
+                            unsigned threadCount = 1);
+
+    // Appends one line per point; values round-trip exactly.
+    static void format(const std::vector<Point>& points, char separator, std::string& out);
+
+    static bool readAll(std::FILE* file, std::vector<char>& out);
+};
+
+#endif // POINTIO_H
@@ -0,0 +1,341 @@
+#include "ThreadPool.h"
+
+#include <chrono>
+#include <iterator>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::atomic<ThreadPool*> g_p_installed{nullptr};
+
+// Set on the pool's own threads, so submit() and runOne() know whose deque
+// is theirs.
+thread_local const ThreadPool* t_p_pool = nullptr;
+thread_local std::size_t t_workerIndex = 0;
+// The group of the task this thread is running, the parent of any group it
+// creates.
+thread_local const ThreadPool::TaskGroup* t_p_runningGroup = nullptr;
+
+std::int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+unsigned hardwareThreads()
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+bool pinCurrentThread(unsigned cpu)
+{
+#ifdef _WIN32
+    if (cpu >= sizeof(DWORD_PTR) * 8) {
+        return false;
+    }
+    return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+} // namespace
+
+ThreadPool::TaskGroup::TaskGroup(ThreadPool& pool)
+    :   m_pool(pool),
+    m_p_parent(t_p_runningGroup),
+    m_pending(0)
+{
+}
+
+ThreadPool::TaskGroup::~TaskGroup()
+{
+    wait();
+}
+
+void ThreadPool::TaskGroup::wait()
+{
+    while (m_pending.load(std::memory_order_acquire) != 0) {
+        if (m_pool.runOne(this)) {
+            continue;
+        }
+        // Nothing of ours is queued; the remaining tasks are running. The
+        // timeout picks up tasks those spawn in the meantime.
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait_for(lock, std::chrono::microseconds(200), [this]() {
+            return m_pending.load(std::memory_order_acquire) == 0;
+        });
+    }
+
+    // The last task notifies under the mutex; taking it once more keeps the
+    // group alive until that task is done with it.
+    std::lock_guard<std::mutex> lock(m_mutex);
+}
+
+void ThreadPool::TaskGroup::finishTask()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        m_done.notify_all();
+    }
+}
+
+ThreadPool::ThreadPool()
+    :   ThreadPool(Options())
+{
+}
+
+ThreadPool::ThreadPool(const Options& options)
+    :   m_options(options),
+    m_queued(0),
+    m_stopping(false),
+    m_statsStartNs(nowNs())
+{
+    if (m_options.threads == 0) {
+        m_options.threads = hardwareThreads();
+    }
+
+    const unsigned workerCount = m_options.threads - 1;
+    m_workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+    for (std::size_t i = 0; i < m_workers.size(); ++i) {
+        m_workers[i]->thread = std::thread(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+
+    for (const std::unique_ptr<Worker>& p_worker : m_workers) {
+        p_worker->thread.join();
+    }
+}
+
+unsigned ThreadPool::concurrency() const
+{
+    return static_cast<unsigned>(m_workers.size()) + 1;
+}
+
+const ThreadPool::Options& ThreadPool::options() const
+{
+    return m_options;
+}
+
+std::vector<ThreadPool::WorkerStats> ThreadPool::stats() const
+{
+    const double elapsedNs = static_cast<double>(std::max<std::int64_t>(1, nowNs() - m_statsStartNs.load()));
+
+    std::vector<WorkerStats> result(m_workers.size());
+    for (std::size_t i = 0; i < m_workers.size(); ++i) {
+        const Worker& worker = *m_workers[i];
+        const double busyNs = static_cast<double>(worker.busyNs.load(std::memory_order_relaxed));
+        result[i].tasks = worker.executed.load(std::memory_order_relaxed);
+        result[i].steals = worker.stolen.load(std::memory_order_relaxed);
+        result[i].busyMs = busyNs / 1e6;
+        result[i].utilization = std::min(1.0, busyNs / elapsedNs);
+        result[i].cpu = worker.cpu.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+void ThreadPool::resetStats()
+{
+    for (const std::unique_ptr<Worker>& p_worker : m_workers) {
+        p_worker->executed.store(0, std::memory_order_relaxed);
+        p_worker->stolen.store(0, std::memory_order_relaxed);
+        p_worker->busyNs.store(0, std::memory_order_relaxed);
+    }
+    m_statsStartNs.store(nowNs());
+}
+
+ThreadPool& ThreadPool::global()
+{
+    if (ThreadPool* p_pool = g_p_installed.load(std::memory_order_acquire)) {
+        return *p_pool;
+    }
+    static ThreadPool fallback;
+    return fallback;
+}
+
+void ThreadPool::install(ThreadPool* pool)
+{
+    g_p_installed.store(pool, std::memory_order_release);
+}
+
+void ThreadPool::submit(std::function<void()> fn, TaskGroup* p_group)
+{
+    Task task;
+    task.fn = std::move(fn);
+    task.p_group = p_group;
+
+    if (t_p_pool == this) {
+        Worker& worker = *m_workers[t_workerIndex];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    } else {
+        std::lock_guard<std::mutex> lock(m_sharedMutex);
+        m_shared.push_back(std::move(task));
+    }
+    m_queued.fetch_add(1, std::memory_order_release);
+
+    // A worker that saw no work checks again under this mutex before it
+    // sleeps, so the notification cannot fall between the two.
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wake.notify_one();
+}
+
+bool ThreadPool::inScope(const Task& task, const TaskGroup* p_scope)
+{
+    if (!p_scope) {
+        return true;
+    }
+    for (const TaskGroup* p_group = task.p_group; p_group; p_group = p_group->m_p_parent) {
+        if (p_group == p_scope) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::takeTask(Task& task, bool& stolen, const TaskGroup* p_scope)
+{
+    stolen = false;
+    const bool isWorker = t_p_pool == this;
+
+    // Without a scope only the ends are looked at; with one, the nearest
+    // matching task, which for nested loops is nearly always at the end too.
+    if (isWorker) {
+        Worker& own = *m_workers[t_workerIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        for (auto it = own.tasks.rbegin(); it != own.tasks.rend(); ++it) {
+            if (inScope(*it, p_scope)) {
+                task = std::move(*it);
+                own.tasks.erase(std::next(it).base());
+                return true;
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_sharedMutex);
+        for (auto it = m_shared.begin(); it != m_shared.end(); ++it) {
+            if (inScope(*it, p_scope)) {
+                task = std::move(*it);
+                m_shared.erase(it);
+                return true;
+            }
+        }
+    }
+
+    // Tasks on the workers' deques were spawned by workers; a thread from
+    // outside the pool leaves them to the pool.
+    if (!isWorker && p_scope) {
+        return false;
+    }
+
+    const std::size_t count = m_workers.size();
+    const std::size_t start = isWorker ? t_workerIndex + 1 : 0;
+    for (std::size_t k = 0; k < count; ++k) {
+        const std::size_t victim = (start + k) % count;
+        if (isWorker && victim == t_workerIndex) {
+            continue;
+        }
+        Worker& other = *m_workers[victim];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        for (auto it = other.tasks.begin(); it != other.tasks.end(); ++it) {
+            if (inScope(*it, p_scope)) {
+                task = std::move(*it);
+                other.tasks.erase(it);
+                stolen = true;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::runOne(const TaskGroup* p_scope)
+{
+    if (m_queued.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    Task task;
+    bool stolen = false;
+    if (!takeTask(task, stolen, p_scope)) {
+        return false;
+    }
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+
+    Worker* p_worker = t_p_pool == this ? m_workers[t_workerIndex].get() : nullptr;
+    const std::int64_t start = p_worker ? nowNs() : 0;
+
+    const TaskGroup* p_outer = t_p_runningGroup;
+    t_p_runningGroup = task.p_group;
+    task.fn();
+    t_p_runningGroup = p_outer;
+
+    if (p_worker) {
+        p_worker->busyNs.fetch_add(nowNs() - start, std::memory_order_relaxed);
+        p_worker->executed.fetch_add(1, std::memory_order_relaxed);
+        if (stolen) {
+            p_worker->stolen.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (task.p_group) {
+        task.p_group->finishTask();
+    }
+    return true;
+}
+
+void ThreadPool::workerLoop(std::size_t index)
+{
+    t_p_pool = this;
+    t_workerIndex = index;
+
+    if (m_options.affinity == Affinity::Compact) {
+        const unsigned cpu = static_cast<unsigned>((m_options.firstCpu + index) % hardwareThreads());
+        if (pinCurrentThread(cpu)) {
+            m_workers[index]->cpu.store(static_cast<int>(cpu), std::memory_order_relaxed);
+        }
+    }
+
+    for (;;) {
+        if (runOne(nullptr)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this]() {
+            return m_stopping || m_queued.load(std::memory_order_acquire) > 0;
+        });
+        if (m_stopping && m_queued.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
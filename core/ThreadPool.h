@@ -0,0 +1,229 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// The process-wide scheduler behind parallelFor() and every other parallel
+// stage, so they share one set of threads instead of each starting its own.
+//
+// Every worker has its own task deque. A worker pushes and pops at the back
+// of its deque, which keeps nested work on the thread that spawned it; idle
+// workers steal from the front of the others' deques. Tasks submitted from
+// outside the pool go to a shared queue.
+//
+// A worker that waits for a TaskGroup runs that group's queued tasks
+// meanwhile, and those of groups nested in it, so nested parallel loops
+// cannot deadlock. It never picks up unrelated work: a short loop must not
+// end up waiting for someone else's long task. Other threads only take back
+// their own group's tasks from the shared queue and otherwise block.
+//
+// Tasks must not throw.
+class ThreadPool
+{
+public:
+    enum class Affinity {
+        None,
+        // Worker i runs only on CPU (firstCpu + i) modulo the CPU count.
+        Compact
+    };
+
+    struct Options
+    {
+        // Threads working on a parallel loop, the calling thread included;
+        // the pool starts one thread fewer. 0 means one per hardware thread.
+        unsigned threads = 0;
+        Affinity affinity = Affinity::None;
+        unsigned firstCpu = 0;
+    };
+
+    struct WorkerStats
+    {
+        std::uint64_t tasks = 0;
+        // Tasks taken from another worker's deque.
+        std::uint64_t steals = 0;
+        double busyMs = 0.0;
+        // Busy time over the time since the pool started or resetStats().
+        double utilization = 0.0;
+        // -1 unless the worker is pinned.
+        int cpu = -1;
+    };
+
+    // Tasks run in it can be waited for together. Waits in the destructor.
+    class TaskGroup
+    {
+    public:
+        explicit TaskGroup(ThreadPool& pool = ThreadPool::global());
+        ~TaskGroup();
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        template<typename Fn>
+        void run(Fn&& fn)
+        {
+            m_pending.fetch_add(1, std::memory_order_relaxed);
+            m_pool.submit(std::function<void()>(std::forward<Fn>(fn)), this);
+        }
+
+        void wait();
+
+    private:
+        friend class ThreadPool;
+        void finishTask();
+
+        ThreadPool& m_pool;
+        // The group of the task that created this one, if any.
+        const TaskGroup* m_p_parent;
+        std::atomic<std::size_t> m_pending;
+        std::mutex m_mutex;
+        std::condition_variable m_done;
+    };
+
+    ThreadPool();
+    explicit ThreadPool(const Options& options);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Workers plus the calling thread.
+    unsigned concurrency() const;
+    const Options& options() const;
+
+    // Splits [begin, end) into chunks of `grain` elements, aligned to
+    // `begin`, and calls fn(chunkBegin, chunkEnd) for each of them. On a
+    // single thread fn is called once for the whole range.
+    template<typename Fn>
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Fn&& fn);
+
+    // map(chunkBegin, chunkEnd) for every chunk, folded with combine() in
+    // chunk order, so the result does not depend on the thread count.
+    template<typename T, typename Map, typename Combine>
+    T parallelReduce(std::size_t begin, std::size_t end, std::size_t grain, T identity,
+                     Map&& map, Combine&& combine);
+
+    std::vector<WorkerStats> stats() const;
+    void resetStats();
+
+    // The pool installed by install(), or a default one created on first use.
+    static ThreadPool& global();
+    // Makes `pool` the global one; nullptr goes back to the default. Only
+    // while no parallel work is running.
+    static void install(ThreadPool* pool);
+
+private:
+    struct Task
+    {
+        std::function<void()> fn;
+        TaskGroup* p_group = nullptr;
+    };
+
+    struct alignas(64) Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+        std::atomic<int> cpu{-1};
+        std::atomic<std::uint64_t> executed{0};
+        std::atomic<std::uint64_t> stolen{0};
+        std::atomic<std::int64_t> busyNs{0};
+    };
+
+    void submit(std::function<void()> fn, TaskGroup* p_group);
+    // Runs one queued task of `p_scope` or a group nested in it, or any
+    // queued task if `p_scope` is null.
+    bool runOne(const TaskGroup* p_scope);
+    bool takeTask(Task& task, bool& stolen, const TaskGroup* p_scope);
+    static bool inScope(const Task& task, const TaskGroup* p_scope);
+    void workerLoop(std::size_t index);
+
+private:
+    Options m_options;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    std::mutex m_sharedMutex;
+    std::deque<Task> m_shared;
+
+    // Tasks queued and not taken yet; workers sleep while it is zero.
+    std::atomic<std::size_t> m_queued;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    bool m_stopping;
+
+    std::atomic<std::int64_t> m_statsStartNs;
+};
+
+template<typename Fn>
+void ThreadPool::parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Fn&& fn)
+{
+    if (begin >= end) {
+        return;
+    }
+
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t chunkCount = (end - begin + grain - 1) / grain;
+    const std::size_t taskCount = std::min<std::size_t>(concurrency(), chunkCount);
+
+    if (taskCount <= 1) {
+        fn(begin, end);
+        return;
+    }
+
+    // A few tasks that claim chunks from a shared counter: balanced like one
+    // task per chunk, without a queue entry per chunk.
+    std::atomic<std::size_t> nextChunk{0};
+    auto drain = [&]() {
+        for (;;) {
+            const std::size_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunkCount) {
+                return;
+            }
+            const std::size_t chunkBegin = begin + chunk * grain;
+            fn(chunkBegin, std::min(chunkBegin + grain, end));
+        }
+    };
+
+    TaskGroup group(*this);
+    for (std::size_t i = 1; i < taskCount; ++i) {
+        group.run(drain);
+    }
+    drain();
+    group.wait();
+}
+
+template<typename T, typename Map, typename Combine>
+T ThreadPool::parallelReduce(std::size_t begin, std::size_t end, std::size_t grain, T identity,
+                             Map&& map, Combine&& combine)
+{
+    if (begin >= end) {
+        return identity;
+    }
+
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t chunkCount = (end - begin + grain - 1) / grain;
+    std::vector<T> partial(chunkCount, identity);
+    parallelFor(0, chunkCount, 1, [&](std::size_t firstChunk, std::size_t lastChunk) {
+        for (std::size_t chunk = firstChunk; chunk < lastChunk; ++chunk) {
+            const std::size_t chunkBegin = begin + chunk * grain;
+            partial[chunk] = map(chunkBegin, std::min(chunkBegin + grain, end));
+        }
+    });
+
+    T result = identity;
+    for (T& value : partial) {
+        result = combine(result, value);
+    }
+    return result;
+}
+
+#endif // THREADPOOL_H
@@ -0,0 +1,346 @@
+#include "HullQuery.h"
+#include "Orientation.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr double Pi = 3.14159265358979323846;
+
+double dot(const Point& a, double ux, double uy)
+{
+    return a.x * ux + a.y * uy;
+}
+
+double distance(const Point& a, const Point& b)
+{
+    return std::hypot(a.x - b.x, a.y - b.y);
+}
+
+} // namespace
+
+HullQuery::HullQuery(const std::vector<Point>& hull)
+{
+    build(hull);
+}
+
+void HullQuery::build(const std::vector<Point>& hull)
+{
+    m_vertices.clear();
+    m_normalAngles.clear();
+    m_diameter = Segment();
+    m_width = Segment();
+    m_minAreaRectangle = Rectangle();
+
+    // Drop repeated and collinear vertices: the binary searches below need a
+    // strictly convex polygon.
+    for (const Point& p : hull) {
+        if (!m_vertices.empty() && m_vertices.back().x == p.x && m_vertices.back().y == p.y) {
+            continue;
+        }
+        while (m_vertices.size() >= 2 &&
+               cross(m_vertices[m_vertices.size() - 2], m_vertices.back(), p) == 0.0) {
+            m_vertices.pop_back();
+        }
+        m_vertices.push_back(p);
+    }
+    while (m_vertices.size() >= 3) {
+        const std::size_t h = m_vertices.size();
+        if (m_vertices[h - 1].x == m_vertices[0].x && m_vertices[h - 1].y == m_vertices[0].y) {
+            m_vertices.pop_back();
+        } else if (cross(m_vertices[h - 2], m_vertices[h - 1], m_vertices[0]) == 0.0) {
+            m_vertices.erase(m_vertices.end() - 1);
+        } else if (cross(m_vertices[h - 1], m_vertices[0], m_vertices[1]) == 0.0) {
+            m_vertices.erase(m_vertices.begin());
+        } else {
+            break;
+        }
+    }
+
+    if (m_vertices.size() < 3) {
+        return;
+    }
+
+    double area = 0.0;
+    for (std::size_t i = 0; i < m_vertices.size(); ++i) {
+        const Point& a = m_vertices[i];
+        const Point& b = m_vertices[(i + 1) % m_vertices.size()];
+        area += a.x * b.y - a.y * b.x;
+    }
+    if (area < 0.0) {
+        std::reverse(m_vertices.begin(), m_vertices.end());
+    }
+
+    // Slivers of nearly collinear floating-point input are not reliably
+    // convex under rounding; they are rejected like any other degenerate hull.
+    double minX = m_vertices[0].x, maxX = minX, minY = m_vertices[0].y, maxY = minY;
+    for (const Point& p : m_vertices) {
+        minX = std::min(minX, p.x);
+        maxX = std::max(maxX, p.x);
+        minY = std::min(minY, p.y);
+        maxY = std::max(maxY, p.y);
+    }
+    const double extent = std::max(maxX - minX, maxY - minY);
+    if (std::abs(area) <= 1e-9 * extent * extent) {
+        m_vertices.clear();
+        return;
+    }
+
+    const auto lowest = std::min_element(m_vertices.begin(), m_vertices.end(),
+                                         [](const Point& a, const Point& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    std::rotate(m_vertices.begin(), lowest, m_vertices.end());
+
+    const int h = static_cast<int>(m_vertices.size());
+    m_normalAngles.resize(h);
+    for (int i = 0; i < h; ++i) {
+        const Point& a = m_vertices[i];
+        const Point& b = m_vertices[(i + 1) % h];
+        double angle = std::atan2(b.y - a.y, b.x - a.x) - Pi / 2.0;
+        if (i > 0) {
+            // Consecutive normals turn by less than pi, so a larger drop is
+            // the wrap-around; smaller drops are rounding on nearly flat
+            // corners and are clamped to keep the sequence sorted.
+            while (angle < m_normalAngles[i - 1] - Pi) {
+                angle += 2.0 * Pi;
+            }
+            angle = std::max(angle, m_normalAngles[i - 1]);
+        }
+        m_normalAngles[i] = angle;
+    }
+
+    computeCalipers();
+}
+
+bool HullQuery::isValid() const
+{
+    return m_vertices.size() >= 3;
+}
+
+const std::vector<Point>& HullQuery::vertices() const
+{
+    return m_vertices;
+}
+
+bool HullQuery::isVisible(int edge, const Point& q) const
+{
+    const int h = static_cast<int>(m_vertices.size());
+    return cross(m_vertices[edge], m_vertices[(edge + 1) % h], q) < 0.0;
+}
+
+// Binary search over the fan of triangles around vertex 0. Returns an edge
+// that q lies strictly outside of, or -1 if q is inside the hull.
+int HullQuery::findVisibleEdge(const Point& q) const
+{
+    const int h = static_cast<int>(m_vertices.size());
+    const Point& origin = m_vertices[0];
+
+    if (cross(origin, m_vertices[1], q) < 0.0) {
+        return 0;
+    }
+    if (cross(origin, m_vertices[h - 1], q) > 0.0) {
+        return h - 1;
+    }
+
+    int low = 1;
+    int high = h - 1;
+    while (high - low > 1) {
+        const int mid = (low + high) / 2;
+        if (cross(origin, m_vertices[mid], q) >= 0.0) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+
+    return isVisible(low, q) ? low : -1;
+}
+
+bool HullQuery::contains(const Point& q) const
+{
+    return isValid() && findVisibleEdge(q) < 0;
+}
+
+int HullQuery::extremeVertex(double dx, double dy) const
+{
+    if (!isValid()) {
+        return m_vertices.empty() ? -1 : 0;
+    }
+
+    // Vertex i is extreme for every direction between the outward normals of
+    // edges i - 1 and i.
+    const double first = m_normalAngles.front();
+    double angle = std::atan2(dy, dx);
+    while (angle < first) {
+        angle += 2.0 * Pi;
+    }
+    while (angle >= first + 2.0 * Pi) {
+        angle -= 2.0 * Pi;
+    }
+
+    const auto it = std::lower_bound(m_normalAngles.begin(), m_normalAngles.end(), angle);
+    const int index = static_cast<int>(it - m_normalAngles.begin());
+    return index == static_cast<int>(m_vertices.size()) ? 0 : index;
+}
+
+// Smallest d in (0, length] such that edge (from + d) has the requested
+// visibility, where the predicate switches exactly once along the range.
+int HullQuery::firstEdgeWithVisibility(int from, int to, bool visible, const Point& q) const
+{
+    const int h = static_cast<int>(m_vertices.size());
+    int low = 0;
+    int high = (to - from + h) % h;
+    while (high - low > 1) {
+        const int mid = (low + high) / 2;
+        if (isVisible((from + mid) % h, q) == visible) {
+            high = mid;
+        } else {
+            low = mid;
+        }
+    }
+    return (from + high) % h;
+}
+
+bool HullQuery::tangents(const Point& q, Tangents& result) const
+{
+    if (!isValid()) {
+        return false;
+    }
+
+    const int visibleEdge = findVisibleEdge(q);
+    if (visibleEdge < 0) {
+        return false;
+    }
+
+    // The vertex extreme in the direction opposite to the visible edge's
+    // outward normal always has an adjacent edge that q cannot see.
+    const int h = static_cast<int>(m_vertices.size());
+    const Point& a = m_vertices[visibleEdge];
+    const Point& b = m_vertices[(visibleEdge + 1) % h];
+    const int far = extremeVertex(-(b.y - a.y), b.x - a.x);
+
+    int hiddenEdge = -1;
+    if (!isVisible(far, q)) {
+        hiddenEdge = far;
+    } else if (!isVisible((far - 1 + h) % h, q)) {
+        hiddenEdge = (far - 1 + h) % h;
+    } else {
+        for (int edge = 0; edge < h; ++edge) {
+            if (!isVisible(edge, q)) {
+                hiddenEdge = edge;
+                break;
+            }
+        }
+    }
+    if (hiddenEdge < 0) {
+        return false;
+    }
+
+    result.second = firstEdgeWithVisibility(visibleEdge, hiddenEdge, false, q);
+    result.first = firstEdgeWithVisibility(hiddenEdge, visibleEdge, true, q);
+    return true;
+}
+
+const HullQuery::Segment& HullQuery::diameter() const
+{
+    return m_diameter;
+}
+
+const HullQuery::Segment& HullQuery::width() const
+{
+    return m_width;
+}
+
+const HullQuery::Rectangle& HullQuery::minAreaRectangle() const
+{
+    return m_minAreaRectangle;
+}
+
+void HullQuery::computeCalipers()
+{
+    const std::vector<Point>& v = m_vertices;
+    const int h = static_cast<int>(v.size());
+
+    auto heightAbove = [&v, h](int edge, int vertex) {
+        return std::abs(cross(v[edge], v[(edge + 1) % h], v[vertex]));
+    };
+
+    // Antipodal vertex of every edge: diameter and width.
+    m_diameter.length = -1.0;
+    m_width.length = -1.0;
+    int antipode = 1;
+    for (int i = 0; i < h; ++i) {
+        const int next = (i + 1) % h;
+        while (heightAbove(i, (antipode + 1) % h) > heightAbove(i, antipode)) {
+            antipode = (antipode + 1) % h;
+        }
+
+        for (int end : {i, next}) {
+            const double length = distance(v[end], v[antipode]);
+            if (length > m_diameter.length) {
+                m_diameter = {v[end], v[antipode], length};
+            }
+        }
+
+        const double edgeLength = distance(v[i], v[next]);
+        const double stripWidth = heightAbove(i, antipode) / edgeLength;
+        if (m_width.length < 0.0 || stripWidth < m_width.length) {
+            const double ux = (v[next].x - v[i].x) / edgeLength;
+            const double uy = (v[next].y - v[i].y) / edgeLength;
+            const double along = (v[antipode].x - v[i].x) * ux + (v[antipode].y - v[i].y) * uy;
+            m_width = {v[antipode], Point(v[i].x + along * ux, v[i].y + along * uy), stripWidth};
+        }
+    }
+
+    // Minimum-area rectangle: one side is flush with an edge, and the three
+    // other sides touch the vertices extreme along the edge (both ways) and
+    // along its inward normal. All three only move forward as i advances.
+    int forward = 0;
+    int backward = 0;
+    int top = 0;
+    m_minAreaRectangle.area = -1.0;
+    for (int i = 0; i < h; ++i) {
+        const int next = (i + 1) % h;
+        const double edgeLength = distance(v[i], v[next]);
+        const double ux = (v[next].x - v[i].x) / edgeLength;
+        const double uy = (v[next].y - v[i].y) / edgeLength;
+        const double nx = -uy;
+        const double ny = ux;
+
+        if (i == 0) {
+            for (int j = 1; j < h; ++j) {
+                if (dot(v[j], ux, uy) > dot(v[forward], ux, uy)) forward = j;
+                if (dot(v[j], ux, uy) < dot(v[backward], ux, uy)) backward = j;
+                if (dot(v[j], nx, ny) > dot(v[top], nx, ny)) top = j;
+            }
+        } else {
+            while (dot(v[(forward + 1) % h], ux, uy) > dot(v[forward], ux, uy)) {
+                forward = (forward + 1) % h;
+            }
+            while (dot(v[(backward + 1) % h], ux, uy) < dot(v[backward], ux, uy)) {
+                backward = (backward + 1) % h;
+            }
+            while (dot(v[(top + 1) % h], nx, ny) > dot(v[top], nx, ny)) {
+                top = (top + 1) % h;
+            }
+        }
+
+        const double low = dot(v[backward], ux, uy) - dot(v[i], ux, uy);
+        const double high = dot(v[forward], ux, uy) - dot(v[i], ux, uy);
+        const double height = dot(v[top], nx, ny) - dot(v[i], nx, ny);
+        const double area = (high - low) * height;
+
+        if (m_minAreaRectangle.area < 0.0 || area < m_minAreaRectangle.area) {
+            const Point& o = v[i];
+            m_minAreaRectangle.area = area;
+            m_minAreaRectangle.corners[0] = Point(o.x + low * ux, o.y + low * uy);
+            m_minAreaRectangle.corners[1] = Point(o.x + high * ux, o.y + high * uy);
+            m_minAreaRectangle.corners[2] = Point(o.x + high * ux + height * nx,
+                                                  o.y + high * uy + height * ny);
+            m_minAreaRectangle.corners[3] = Point(o.x + low * ux + height * nx,
+                                                  o.y + low * uy + height * ny);
+        }
+    }
+}
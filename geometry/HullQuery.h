@@ -0,0 +1,69 @@
+#ifndef HULLQUERY_H
+#define HULLQUERY_H
+
+#include <vector>
+
+#include "Point.h"
+
+// Query structure over a convex polygon such as AppState::hull(). Building is
+// O(h); containment, tangents and extreme vertices are O(log h). Diameter,
+// width and the minimum-area bounding rectangle come from rotating calipers
+// and are computed once while building.
+class HullQuery
+{
+public:
+    struct Segment {
+        Point a;
+        Point b;
+        double length = 0.0;
+    };
+
+    struct Rectangle {
+        Point corners[4];
+        double area = 0.0;
+    };
+
+    // Tangent vertices seen from an outside point. The chain of hull edges
+    // visible from that point runs counter-clockwise from `first` to `second`.
+    struct Tangents {
+        int first = -1;
+        int second = -1;
+    };
+
+    HullQuery() = default;
+    explicit HullQuery(const std::vector<Point>& hull);
+
+    void build(const std::vector<Point>& hull);
+
+    // Queries need a proper polygon, i.e. at least three vertices.
+    bool isValid() const;
+    const std::vector<Point>& vertices() const;
+
+    // Points on the boundary count as inside.
+    bool contains(const Point& q) const;
+    // Returns false if q is inside the hull.
+    bool tangents(const Point& q, Tangents& result) const;
+    int extremeVertex(double dx, double dy) const;
+
+    const Segment& diameter() const;
+    const Segment& width() const;
+    const Rectangle& minAreaRectangle() const;
+
+private:
+    bool isVisible(int edge, const Point& q) const;
+    int findVisibleEdge(const Point& q) const;
+    int firstEdgeWithVisibility(int from, int to, bool visible, const Point& q) const;
+    void computeCalipers();
+
+private:
+    // Counter-clockwise, starting at the lexicographically smallest vertex.
+    std::vector<Point> m_vertices;
+    // Angle of each edge's outward normal, strictly increasing over 2*pi.
+    std::vector<double> m_normalAngles;
+
+    Segment m_diameter;
+    Segment m_width;
+    Rectangle m_minAreaRectangle;
+};
+
+#endif // HULLQUERY_H
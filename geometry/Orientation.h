@@ -10,9 +10,47 @@ enum class Orientation
     CounterClockWise
 };
 
-inline Orientation orientation(const Point& a, const Point& b, const Point& c)
+// Arithmetic type used to evaluate predicates for a coordinate type. Integer
+// coordinates are widened so that products of differences are exact.
+template<typename T>
+struct PredicateTraits
 {
-    double value = (b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x);
+    using Wide = T;
+};
+
+template<>
+struct PredicateTraits<std::int32_t>
+{
+    using Wide = std::int64_t;
+};
+
+template<typename T>
+inline typename PredicateTraits<T>::Wide
+cross(const BasicPoint<T>& a, const BasicPoint<T>& b, const BasicPoint<T>& c)
+{
+    using Wide = typename PredicateTraits<T>::Wide;
+    return (Wide(b.x) - a.x) * (Wide(c.y) - b.y) - (Wide(b.y) - a.y) * (Wide(c.x) - b.x);
+}
+
+template<typename T>
+inline typename PredicateTraits<T>::Wide
+squaredDistance(const BasicPoint<T>& a, const BasicPoint<T>& b)
+{
+    using Wide = typename PredicateTraits<T>::Wide;
+    const Wide dx = Wide(a.x) - b.x;
+    const Wide dy = Wide(a.y) - b.y;
+    return dx * dx + dy * dy;
+}
+
+// Number of orientation() evaluations made on the calling thread. Tools that
+// compare algorithms reset and read it around a run.
+inline thread_local std::uint64_t orientationTestCount = 0;
+
+template<typename T>
+inline Orientation orientation(const BasicPoint<T>& a, const BasicPoint<T>& b, const BasicPoint<T>& c)
+{
+    ++orientationTestCount;
+    const auto value = cross(a, b, c);
 
     if (value > 0) {
         return Orientation::CounterClockWise;
@@ -1,13 +1,23 @@
 #ifndef POINT_H
 #define POINT_H
 
-struct Point
+#include <cstdint>
+
+template<typename T>
+struct BasicPoint
 {
-    double x;
-    double y;
+    T x;
+    T y;
 
-    Point() : x(0.0), y(0.0) {}
-    Point(double x_, double y_) : x(x_), y(y_) {}
+    BasicPoint() : x(0), y(0) {}
+    BasicPoint(T x_, T y_) : x(x_), y(y_) {}
 };
 
+using Point = BasicPoint<double>;
+
+// Integer input points. Predicates on them are evaluated exactly in 64-bit
+// arithmetic, which holds as long as every coordinate lies in
+// [-2^30, 2^30); see fitsIntegerKernel().
+using PointI = BasicPoint<std::int32_t>;
+
 #endif // POINT_H
@@ -0,0 +1,59 @@
+#ifndef POINTCONVERSION_H
+#define POINTCONVERSION_H
+
+#include <cmath>
+#include <vector>
+
+#include "Point.h"
+
+constexpr double IntegerKernelLimit = 1073741824.0; // 2^30
+
+inline bool fitsIntegerKernel(const Point& p)
+{
+    return p.x >= -IntegerKernelLimit && p.x < IntegerKernelLimit &&
+           p.y >= -IntegerKernelLimit && p.y < IntegerKernelLimit &&
+           std::floor(p.x) == p.x && std::floor(p.y) == p.y;
+}
+
+// Converts to integer points if every point has integral coordinates inside
+// the exact range of the 64-bit predicates. Leaves `out` unspecified and
+// returns false otherwise.
+inline bool toIntegerPoints(const std::vector<Point>& points, std::vector<PointI>& out)
+{
+    out.resize(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        const Point& p = points[i];
+        if (!fitsIntegerKernel(p)) {
+            return false;
+        }
+        out[i] = PointI(static_cast<std::int32_t>(p.x), static_cast<std::int32_t>(p.y));
+    }
+    return true;
+}
+
+inline void toPoints(const std::vector<PointI>& points, std::vector<Point>& out)
+{
+    out.resize(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        out[i] = Point(points[i].x, points[i].y);
+    }
+}
+
+inline std::vector<Point> toPoints(const std::vector<PointI>& points)
+{
+    std::vector<Point> out;
+    toPoints(points, out);
+    return out;
+}
+
+inline std::vector<PointI> toIntegerPointsUnchecked(const std::vector<Point>& points)
+{
+    std::vector<PointI> out;
+    out.reserve(points.size());
+    for (const Point& p : points) {
+        out.emplace_back(static_cast<std::int32_t>(p.x), static_cast<std::int32_t>(p.y));
+    }
+    return out;
+}
+
+#endif // POINTCONVERSION_H
@@ -0,0 +1,88 @@
+#include "QuadTree.h"
+
+#include <algorithm>
+
+void QuadTree::build(const std::vector<Point>& points)
+{
+    m_points = points;
+    m_nodes.clear();
+
+    if (m_points.empty()) {
+        return;
+    }
+
+    Bounds bounds{m_points[0].x, m_points[0].y, m_points[0].x, m_points[0].y};
+    for (const Point& p : m_points) {
+        bounds.minX = std::min(bounds.minX, p.x);
+        bounds.minY = std::min(bounds.minY, p.y);
+        bounds.maxX = std::max(bounds.maxX, p.x);
+        bounds.maxY = std::max(bounds.maxY, p.y);
+    }
+
+    m_nodes.reserve(2 * m_points.size() / LeafCapacity + 1);
+    m_nodes.push_back({bounds, 0, static_cast<std::uint32_t>(m_points.size()), -1});
+    subdivide(0, 0);
+}
+
+void QuadTree::clear()
+{
+    m_nodes.clear();
+    m_points.clear();
+}
+
+std::size_t QuadTree::size() const
+{
+    return m_points.size();
+}
+
+bool QuadTree::empty() const
+{
+    return m_points.empty();
+}
+
+std::size_t QuadTree::count(const Bounds& rect) const
+{
+    std::size_t total = 0;
+    queryRanges(rect, [&total](const Point* first, const Point* last) {
+        total += static_cast<std::size_t>(last - first);
+    });
+    return total;
+}
+
+void QuadTree::subdivide(std::size_t nodeIndex, int depth)
+{
+    const Node node = m_nodes[nodeIndex];
+    if (node.end - node.begin <= LeafCapacity || depth >= MaxDepth) {
+        return;
+    }
+
+    const double midX = (node.bounds.minX + node.bounds.maxX) / 2.0;
+    const double midY = (node.bounds.minY + node.bounds.maxY) / 2.0;
+
+    auto first = m_points.begin() + node.begin;
+    auto last = m_points.begin() + node.end;
+
+    auto splitY = std::partition(first, last, [midY](const Point& p) { return p.y < midY; });
+    auto splitLowX = std::partition(first, splitY, [midX](const Point& p) { return p.x < midX; });
+    auto splitHighX = std::partition(splitY, last, [midX](const Point& p) { return p.x < midX; });
+
+    const auto offset = [this](std::vector<Point>::iterator it) {
+        return static_cast<std::uint32_t>(it - m_points.begin());
+    };
+
+    const Bounds& b = node.bounds;
+    const Node children[4] = {
+        {{b.minX, b.minY, midX, midY}, node.begin, offset(splitLowX), -1},
+        {{midX, b.minY, b.maxX, midY}, offset(splitLowX), offset(splitY), -1},
+        {{b.minX, midY, midX, b.maxY}, offset(splitY), offset(splitHighX), -1},
+        {{midX, midY, b.maxX, b.maxY}, offset(splitHighX), node.end, -1}
+    };
+
+    const auto firstChild = static_cast<std::int32_t>(m_nodes.size());
+    m_nodes[nodeIndex].firstChild = firstChild;
+    m_nodes.insert(m_nodes.end(), std::begin(children), std::end(children));
+
+    for (int child = 0; child < 4; ++child) {
+        subdivide(firstChild + child, depth + 1);
+    }
+}
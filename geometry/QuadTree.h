@@ -0,0 +1,134 @@
+#ifndef QUADTREE_H
+#define QUADTREE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Point.h"
+
+// Static point quadtree. build() copies the points and reorders them so that
+// every node owns a contiguous range, which lets queries emit whole subtrees
+// that lie inside the query rectangle without testing individual points.
+class QuadTree
+{
+public:
+    struct Bounds {
+        double minX;
+        double minY;
+        double maxX;
+        double maxY;
+
+        bool contains(const Point& p) const
+        {
+            return p.x >= minX && p.x <= maxX && p.y >= minY && p.y <= maxY;
+        }
+
+        bool contains(const Bounds& other) const
+        {
+            return other.minX >= minX && other.maxX <= maxX &&
+                   other.minY >= minY && other.maxY <= maxY;
+        }
+
+        bool intersects(const Bounds& other) const
+        {
+            return other.minX <= maxX && other.maxX >= minX &&
+                   other.minY <= maxY && other.maxY >= minY;
+        }
+    };
+
+    void build(const std::vector<Point>& points);
+    void clear();
+
+    std::size_t size() const;
+    bool empty() const;
+
+    // Calls visit(const Point*, const Point*) once per contiguous run of points
+    // inside the query rectangle.
+    template<typename Visitor>
+    void queryRanges(const Bounds& rect, Visitor&& visit) const;
+
+    // Calls visit(const Point&) for every point inside the query rectangle.
+    template<typename Visitor>
+    void query(const Bounds& rect, Visitor&& visit) const;
+
+    std::size_t count(const Bounds& rect) const;
+
+private:
+    static constexpr std::size_t LeafCapacity = 64;
+    static constexpr int MaxDepth = 24;
+
+    struct Node {
+        Bounds bounds;
+        std::uint32_t begin;
+        std::uint32_t end;
+        std::int32_t firstChild;
+    };
+
+    void subdivide(std::size_t nodeIndex, int depth);
+
+private:
+    std::vector<Node> m_nodes;
+    std::vector<Point> m_points;
+};
+
+template<typename Visitor>
+void QuadTree::queryRanges(const Bounds& rect, Visitor&& visit) const
+{
+    if (m_nodes.empty()) {
+        return;
+    }
+
+    std::int32_t stack[MaxDepth * 3 + 4];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const Node& node = m_nodes[stack[--top]];
+
+        if (!rect.intersects(node.bounds) || node.begin == node.end) {
+            continue;
+        }
+
+        const Point* first = m_points.data() + node.begin;
+        const Point* last = m_points.data() + node.end;
+
+        if (rect.contains(node.bounds)) {
+            visit(first, last);
+            continue;
+        }
+
+        if (node.firstChild < 0) {
+            const Point* runBegin = nullptr;
+            for (const Point* p = first; p != last; ++p) {
+                if (rect.contains(*p)) {
+                    if (!runBegin) {
+                        runBegin = p;
+                    }
+                } else if (runBegin) {
+                    visit(runBegin, p);
+                    runBegin = nullptr;
+                }
+            }
+            if (runBegin) {
+                visit(runBegin, last);
+            }
+            continue;
+        }
+
+        for (int child = 3; child >= 0; --child) {
+            stack[top++] = node.firstChild + child;
+        }
+    }
+}
+
+template<typename Visitor>
+void QuadTree::query(const Bounds& rect, Visitor&& visit) const
+{
+    queryRanges(rect, [&visit](const Point* first, const Point* last) {
+        for (const Point* p = first; p != last; ++p) {
+            visit(*p);
+        }
+    });
+}
+
+#endif // QUADTREE_H
@@ -0,0 +1,58 @@
+#include "ComparisonDialog.h"
+
+#include <QHeaderView>
+#include <QLabel>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+ComparisonDialog::ComparisonDialog(QWidget* parent)
+    :   QDialog(parent)
+{
+    setWindowTitle("Algorithm comparison");
+    resize(720, 220);
+
+    m_p_statusLabel = new QLabel(this);
+
+    m_p_table = new QTableWidget(this);
+    m_p_table->setColumnCount(6);
+    m_p_table->setHorizontalHeaderLabels({"Algorithm", "Time (ms)", "Orientation tests",
+                                          "Scratch memory (MB)", "Hull size", "Matches"});
+    m_p_table->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    m_p_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+
+    QVBoxLayout* p_layout = new QVBoxLayout(this);
+    p_layout->addWidget(m_p_statusLabel);
+    p_layout->addWidget(m_p_table);
+}
+
+void ComparisonDialog::showRunning(std::size_t pointCount)
+{
+    m_p_statusLabel->setText(QString("Running all algorithms on %1 points...").arg(pointCount));
+    m_p_table->setRowCount(0);
+}
+
+void ComparisonDialog::showResults(const std::vector<ComparisonResult>& results)
+{
+    bool allMatch = true;
+    m_p_table->setRowCount(static_cast<int>(results.size()));
+
+    for (int row = 0; row < static_cast<int>(results.size()); ++row) {
+        const ComparisonResult& result = results[row];
+        allMatch = allMatch && result.matchesReference;
+
+        const QStringList cells = {
+            result.name,
+            QString::number(result.milliseconds, 'f', 3),
+            QString::number(result.orientationTests),
+            QString::number(result.scratchBytes / (1024.0 * 1024.0), 'f', 2),
+            QString::number(result.hullSize),
+            result.matchesReference ? "yes" : "NO"
+        };
+        for (int column = 0; column < cells.size(); ++column) {
+            m_p_table->setItem(row, column, new QTableWidgetItem(cells[column]));
+        }
+    }
+
+    m_p_statusLabel->setText(allMatch ? "All algorithms produced the same hull."
+                                      : "Hull mismatch between algorithms!");
+}
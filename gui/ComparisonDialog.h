@@ -0,0 +1,27 @@
+#ifndef COMPARISONDIALOG_H
+#define COMPARISONDIALOG_H
+
+#include <QDialog>
+#include <vector>
+
+#include "../core/ComparisonRunner.h"
+
+class QLabel;
+class QTableWidget;
+
+class ComparisonDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit ComparisonDialog(QWidget* parent = nullptr);
+
+    void showRunning(std::size_t pointCount);
+    void showResults(const std::vector<ComparisonResult>& results);
+
+private:
+    QLabel* m_p_statusLabel;
+    QTableWidget* m_p_table;
+};
+
+#endif // COMPARISONDIALOG_H
@@ -0,0 +1,78 @@
+#include "DensityRenderer.h"
+#include "../core/Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr int TileRows = 16;
+constexpr int SaturationCount = 64;
+}
+
+void DensityRenderer::render(const QuadTree& index, const QSize& size,
+                             double scale, const QPointF& offset,
+                             const QColor& color, QImage& target)
+{
+    const int width = size.width();
+    const int height = size.height();
+
+    if (target.size() != size || target.format() != QImage::Format_ARGB32_Premultiplied) {
+        target = QImage(size, QImage::Format_ARGB32_Premultiplied);
+    }
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    m_counts.assign(static_cast<std::size_t>(width) * height, 0);
+
+    // Opacity per count on a log scale, so sparse pixels stay visible while
+    // dense clusters still saturate.
+    QRgb palette[SaturationCount + 1];
+    for (int count = 0; count <= SaturationCount; ++count) {
+        const double t = std::log1p(count) / std::log1p(SaturationCount);
+        const int alpha = static_cast<int>(std::lround(255.0 * t));
+        palette[count] = qPremultiply(qRgba(color.red(), color.green(), color.blue(), alpha));
+    }
+
+    // Fetch the pixel pointer once: bits() may detach, which must not happen
+    // concurrently from the tile workers.
+    uchar* const pixels = target.bits();
+    const qsizetype bytesPerLine = target.bytesPerLine();
+
+    const std::size_t tileCount = (height + TileRows - 1) / TileRows;
+
+    parallelFor(0, tileCount, 1, [&](std::size_t firstTile, std::size_t lastTile) {
+        for (std::size_t tile = firstTile; tile < lastTile; ++tile) {
+            const int rowBegin = static_cast<int>(tile) * TileRows;
+            const int rowEnd = std::min(rowBegin + TileRows, height);
+
+            const QuadTree::Bounds strip{
+                -offset.x() / scale,
+                (rowBegin - offset.y()) / scale,
+                (width - offset.x()) / scale,
+                (rowEnd - offset.y()) / scale
+            };
+
+            quint32* counts = m_counts.data() + static_cast<std::size_t>(rowBegin) * width;
+
+            index.queryRanges(strip, [&](const Point* first, const Point* last) {
+                for (const Point* p = first; p != last; ++p) {
+                    const int column = static_cast<int>(std::floor(p->x * scale + offset.x()));
+                    const int row = static_cast<int>(std::floor(p->y * scale + offset.y()));
+                    if (column < 0 || column >= width || row < rowBegin || row >= rowEnd) {
+                        continue;
+                    }
+                    ++counts[static_cast<std::size_t>(row - rowBegin) * width + column];
+                }
+            });
+
+            for (int row = rowBegin; row < rowEnd; ++row) {
+                QRgb* line = reinterpret_cast<QRgb*>(pixels + row * bytesPerLine);
+                const quint32* rowCounts = counts + static_cast<std::size_t>(row - rowBegin) * width;
+                for (int column = 0; column < width; ++column) {
+                    line[column] = palette[std::min<quint32>(rowCounts[column], SaturationCount)];
+                }
+            }
+        }
+    });
+}
@@ -0,0 +1,27 @@
+#ifndef DENSITYRENDERER_H
+#define DENSITYRENDERER_H
+
+#include <QColor>
+#include <QImage>
+#include <QPointF>
+#include <QSize>
+#include <vector>
+
+#include "../geometry/QuadTree.h"
+
+// Aggregated renderer for point sets that are denser than the screen: points
+// are binned into one counter per pixel and the counts are mapped to the
+// opacity of a single color. The image is split into horizontal tiles that are
+// filled in parallel, each tile querying the quadtree for its own strip only.
+class DensityRenderer
+{
+public:
+    void render(const QuadTree& index, const QSize& size,
+                double scale, const QPointF& offset,
+                const QColor& color, QImage& target);
+
+private:
+    std::vector<quint32> m_counts;
+};
+
+#endif // DENSITYRENDERER_H
@@ -1,106 +1,251 @@
 #include "DrawWidget.h"
 
 #include <QPainter>
+#include <QPolygonF>
 #include <QFont>
+#include <QMouseEvent>
+#include <QWheelEvent>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr double MinScale = 1e-3;
+constexpr double MaxScale = 1e4;
+constexpr int MaxMarkerSize = 8;
+constexpr std::size_t DefaultDensityThreshold = 200000;
+}
 
 DrawWidget::DrawWidget(AppState* state, QWidget* parent)
-    :   QWidget(parent), m_p_state(state)
+    :   QWidget(parent), m_p_state(state),
+    m_indexRevision(~quint64(0)),
+    m_renderMode(RenderMode::Auto),
+    m_densityThreshold(DefaultDensityThreshold),
+    m_sceneDirty(true),
+    m_scale(1.0),
+    m_offset(0.0, 0.0),
+    m_isPanning(false),
+    m_hasHover(false)
 {
+    setMouseTracking(true);
     connect(m_p_state, &AppState::stateChanged, this, &DrawWidget::onStateChanged);
 }
 
+void DrawWidget::resetView()
+{
+    m_scale = 1.0;
+    m_offset = QPointF(0.0, 0.0);
+    invalidateScene();
+}
+
+void DrawWidget::setRenderMode(RenderMode mode)
+{
+    m_renderMode = mode;
+    invalidateScene();
+}
+
+void DrawWidget::setDensityThreshold(std::size_t visiblePoints)
+{
+    m_densityThreshold = visiblePoints;
+    invalidateScene();
+}
+
 void DrawWidget::onStateChanged()
 {
+    invalidateScene();
+}
+
+void DrawWidget::invalidateScene()
+{
+    m_sceneDirty = true;
     update();
 }
 
+QPointF DrawWidget::toScreen(const Point& p) const
+{
+    return QPointF(p.x * m_scale + m_offset.x(), p.y * m_scale + m_offset.y());
+}
+
+Point DrawWidget::toWorld(const QPointF& p) const
+{
+    return Point((p.x() - m_offset.x()) / m_scale, (p.y() - m_offset.y()) / m_scale);
+}
+
+QuadTree::Bounds DrawWidget::visibleWorldBounds(double marginPx) const
+{
+    const Point topLeft = toWorld(QPointF(-marginPx, -marginPx));
+    const Point bottomRight = toWorld(QPointF(width() + marginPx, height() + marginPx));
+    return {topLeft.x, topLeft.y, bottomRight.x, bottomRight.y};
+}
+
+void DrawWidget::updateIndex()
+{
+    if (m_indexRevision == m_p_state->pointsRevision()) {
+        return;
+    }
+
+    m_index.build(m_p_state->points());
+    m_indexRevision = m_p_state->pointsRevision();
+}
+
+void DrawWidget::drawMarker(QPainter& painter, const Point& p, const QColor& color, int size)
+{
+    const QPointF center = toScreen(p);
+
+    painter.setBrush(color);
+    painter.setPen(Qt::NoPen);
+    painter.drawEllipse(center, size, size);
+
+    painter.setPen(QPen(Qt::white, 1));
+    painter.setBrush(Qt::NoBrush);
+    painter.drawEllipse(center, size, size);
+}
+
+// The scene is cached, so a frame that only moves the hover overlay costs a
+// blit instead of another pass over the points.
 void DrawWidget::paintEvent(QPaintEvent*)
 {
+    const qreal ratio = devicePixelRatioF();
+    const QSize pixels = size() * ratio;
+    if (m_sceneDirty || m_sceneCache.size() != pixels) {
+        if (m_sceneCache.size() != pixels) {
+            m_sceneCache = QPixmap(pixels);
+        }
+        m_sceneCache.setDevicePixelRatio(ratio);
+        m_sceneCache.fill(Qt::transparent);
+
+        QPainter scenePainter(&m_sceneCache);
+        scenePainter.setRenderHint(QPainter::Antialiasing);
+        paintScene(scenePainter);
+        m_sceneDirty = false;
+    }
+
     QPainter painter(this);
+    painter.drawPixmap(0, 0, m_sceneCache);
     painter.setRenderHint(QPainter::Antialiasing);
+    drawHullQueries(painter);
+}
+
+void DrawWidget::paintScene(QPainter& painter)
+{
+    updateIndex();
 
     const AnimationStep* step = m_p_state->currentStep();
+    const QuadTree::Bounds visible = visibleWorldBounds(MaxMarkerSize + 1);
+
+    bool useDensity = m_renderMode == RenderMode::Density;
+    if (m_renderMode == RenderMode::Auto) {
+        useDensity = m_index.size() > m_densityThreshold &&
+                     m_index.count(visible) > m_densityThreshold;
+    }
 
-    painter.setPen(QPen(Qt::green, 2));
+    // Step point sets this large only come from "all points" steps such as
+    // the sort; in density mode they tint the density layer instead of being
+    // drawn one by one.
+    const bool highlightAsDensity = useDensity && step &&
+                                    step->type == AnimationStep::HIGHLIGHT_POINT &&
+                                    step->points.size() > m_densityThreshold;
+
+    if (useDensity) {
+        const QColor densityColor = highlightAsDensity ? QColor(255, 100, 0) : QColor(200, 200, 200);
+        m_densityRenderer.render(m_index, size(), m_scale, m_offset, densityColor, m_densityImage);
+        painter.drawImage(0, 0, m_densityImage);
+    }
+
+    // A polyline is drawn as one, below everything else. Past the density
+    // threshold the segments would cost more than the rest of the frame.
+    const std::vector<Point>& points = m_p_state->points();
+    if (m_p_state->inputMode() == AppState::InputMode::Polyline && !useDensity &&
+        points.size() <= m_densityThreshold) {
+        QPolygonF path(static_cast<int>(points.size()));
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            path[static_cast<int>(i)] = toScreen(points[i]);
+        }
+        painter.setPen(QPen(QColor(110, 110, 140), 1));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawPolyline(path);
+    }
+
+    // Each layer gets its own hue; the golden angle keeps neighbouring
+    // layers apart however many there are.
+    const ConvexLayers* p_layers = m_p_state->convexLayers();
+    if (p_layers) {
+        painter.setBrush(Qt::NoBrush);
+        QPolygonF polygon;
+        for (std::size_t i = 0; i < p_layers->layerCount(); ++i) {
+            const std::vector<Point>& layer = p_layers->layer(i);
+            polygon.resize(static_cast<int>(layer.size()));
+            for (std::size_t j = 0; j < layer.size(); ++j) {
+                polygon[static_cast<int>(j)] = toScreen(layer[j]);
+            }
+            painter.setPen(QPen(QColor::fromHsv(static_cast<int>(i * 137.508) % 360, 200, 255), 1.5));
+            painter.drawPolygon(polygon);
+        }
+    }
+
+    // A preview hull is dashed until the exact one replaces it.
+    painter.setPen(QPen(Qt::green, 2, m_p_state->hullIsApproximate() ? Qt::DashLine : Qt::SolidLine));
     const auto& hull = m_p_state->hull();
     if (!hull.empty()) {
         for (size_t i = 0; i < hull.size(); ++i) {
             size_t next = (i + 1) % hull.size();
-            painter.drawLine(QPointF(hull[i].x, hull[i].y),
-                             QPointF(hull[next].x, hull[next].y));
+            painter.drawLine(toScreen(hull[i]), toScreen(hull[next]));
         }
     }
 
     if (step && step->type == AnimationStep::HIGHLIGHT_LINE && step->points.size() >= 2) {
         painter.setPen(QPen(QColor(255, 200, 0), 2, Qt::DashLine));
         for (size_t i = 0; i < step->points.size() - 1; ++i) {
-            painter.drawLine(QPointF(step->points[i].x, step->points[i].y),
-                             QPointF(step->points[i+1].x, step->points[i+1].y));
+            painter.drawLine(toScreen(step->points[i]), toScreen(step->points[i+1]));
         }
         if (step->points.size() == 3) {
-            painter.drawLine(QPointF(step->points[2].x, step->points[2].y),
-                             QPointF(step->points[0].x, step->points[0].y));
+            painter.drawLine(toScreen(step->points[2]), toScreen(step->points[0]));
         }
     }
 
-    auto contains = [](const std::vector<Point>& vec, const Point& p) {
-        for (const Point& pt : vec) {
-            if (std::abs(pt.x - p.x) < 0.01 && std::abs(pt.y - p.y) < 0.01) {
-                return true;
-            }
+    // Points are layered instead of classified one by one: every visible
+    // point is drawn plain first, then hull vertices and the current step's
+    // points are drawn on top. The index keeps the base layer proportional
+    // to what is on screen.
+    if (!useDensity) {
+        m_index.query(visible, [&](const Point& p) {
+            drawMarker(painter, p, Qt::gray, 4);
+        });
+    }
+
+    for (const Point& p : hull) {
+        if (visible.contains(p)) {
+            drawMarker(painter, p, QColor(0, 200, 0), 6);
         }
-        return false;
-    };
+    }
 
-    for (const Point& p : m_p_state->points()) {
-        QColor color;
-        int size;
+    if (step) {
+        if (step->type == AnimationStep::REMOVE_FROM_HULL) {
+            const int size = 8;
+            for (const Point& p : step->points) {
+                if (!visible.contains(p)) {
+                    continue;
+                }
+                const QPointF center = toScreen(p);
 
-        bool isHighlighted = false;
-        bool isInHull = contains(hull, p);
+                painter.setBrush(QColor(255, 0, 0));
+                painter.setPen(Qt::NoPen);
+                painter.drawEllipse(center, size, size);
 
-        if (step) {
-            if (step->type == AnimationStep::HIGHLIGHT_POINT ||
-                step->type == AnimationStep::ADD_TO_HULL ||
-                step->type == AnimationStep::HIGHLIGHT_LINE) {
-                isHighlighted = contains(step->points, p);
+                painter.setPen(QPen(Qt::white, 2));
+                painter.drawLine(center + QPointF(-size, -size), center + QPointF(size, size));
+                painter.drawLine(center + QPointF(-size, size), center + QPointF(size, -size));
             }
-            if (step->type == AnimationStep::REMOVE_FROM_HULL) {
-                if (contains(step->points, p)) {
-                    color = QColor(255, 0, 0);
-                    size = 8;
-                    painter.setBrush(color);
-                    painter.setPen(Qt::NoPen);
-                    painter.drawEllipse(QPointF(p.x, p.y), size, size);
-
-                    painter.setPen(QPen(Qt::white, 2));
-                    painter.drawLine(QPointF(p.x - size, p.y - size),
-                                     QPointF(p.x + size, p.y + size));
-                    painter.drawLine(QPointF(p.x - size, p.y + size),
-                                     QPointF(p.x + size, p.y - size));
-                    continue;
+        } else if (!highlightAsDensity &&
+                   (step->type == AnimationStep::HIGHLIGHT_POINT ||
+                    step->type == AnimationStep::ADD_TO_HULL ||
+                    step->type == AnimationStep::HIGHLIGHT_LINE)) {
+            for (const Point& p : step->points) {
+                if (visible.contains(p)) {
+                    drawMarker(painter, p, QColor(255, 100, 0), 8);
                 }
             }
         }
-
-        if (isHighlighted) {
-            color = QColor(255, 100, 0);
-            size = 8;
-        } else if (isInHull) {
-            color = QColor(0, 200, 0);
-            size = 6;
-        } else {
-            color = Qt::gray;
-            size = 4;
-        }
-
-        painter.setBrush(color);
-        painter.setPen(Qt::NoPen);
-        painter.drawEllipse(QPointF(p.x, p.y), size, size);
-
-        painter.setPen(QPen(Qt::white, 1));
-        painter.setBrush(Qt::NoBrush);
-        painter.drawEllipse(QPointF(p.x, p.y), size, size);
     }
 
     if (m_p_state->totalSteps() > 0) {
@@ -118,11 +263,158 @@ void DrawWidget::paintEvent(QPaintEvent*)
         }
     }
 
+    if (p_layers) {
+        painter.setPen(Qt::white);
+        painter.setFont(QFont("Arial", 10));
+        painter.drawText(10, height() - 50, QString("Convex layers: %1").arg(p_layers->layerCount()));
+    }
+
+    if (m_p_state->deduplicate() && m_p_state->inputMode() == AppState::InputMode::Points &&
+        (m_p_state->finished() || m_p_state->totalSteps() > 0)) {
+        painter.setPen(Qt::white);
+        painter.setFont(QFont("Arial", 10));
+        painter.drawText(10, height() - 70, QString("Duplicates removed: %1").arg(m_p_state->duplicatesRemoved()));
+    }
+
+    if (m_scale != 1.0) {
+        painter.setPen(Qt::white);
+        painter.setFont(QFont("Arial", 10));
+        painter.drawText(width() - 110, 20, QString("Zoom: %1x").arg(m_scale, 0, 'g', 3));
+    }
+
     if (m_p_state->finished()) {
         painter.setPen(Qt::white);
         painter.setFont(QFont("Arial", 11, QFont::Bold));
         QString timeInfo = QString("Time: %1 s")
                                .arg(m_p_state->elapsedTimeMs(), 0, 'f', 4);
         painter.drawText(10, height() - 10, timeInfo);
+
+        const QString decision = m_p_state->algorithmDecision();
+        if (!decision.isEmpty()) {
+            painter.setFont(QFont("Arial", 10));
+            painter.drawText(10, height() - 30, "Auto: " + decision);
+        }
+
+        if (m_p_state->hullIsApproximate()) {
+            painter.setFont(QFont("Arial", 10));
+            painter.drawText(10, height() - 30, QString("Approximate hull, error ≤ %1 — refining")
+                                                    .arg(m_p_state->hullErrorBound(), 0, 'f', 2));
+        }
+    }
+}
+
+// Hover feedback from the hull query structure: containment, tangents and the
+// extreme vertex towards the cursor, plus the rotating-calipers results.
+void DrawWidget::drawHullQueries(QPainter& painter)
+{
+    if (!m_hasHover) {
+        return;
+    }
+
+    const HullQuery& query = m_p_state->hullQuery();
+    if (!query.isValid()) {
+        return;
+    }
+
+    const std::vector<Point>& vertices = query.vertices();
+
+    const HullQuery::Rectangle& rectangle = query.minAreaRectangle();
+    painter.setPen(QPen(QColor(100, 160, 255), 1, Qt::DotLine));
+    painter.setBrush(Qt::NoBrush);
+    for (int i = 0; i < 4; ++i) {
+        painter.drawLine(toScreen(rectangle.corners[i]), toScreen(rectangle.corners[(i + 1) % 4]));
+    }
+
+    const HullQuery::Segment& diameter = query.diameter();
+    painter.setPen(QPen(QColor(220, 80, 220), 1, Qt::DashLine));
+    painter.drawLine(toScreen(diameter.a), toScreen(diameter.b));
+
+    const Point cursor = toWorld(m_hoverPos);
+    const Point center((diameter.a.x + diameter.b.x) / 2.0, (diameter.a.y + diameter.b.y) / 2.0);
+    const int extreme = query.extremeVertex(cursor.x - center.x, cursor.y - center.y);
+
+    painter.setPen(QPen(QColor(100, 160, 255), 2));
+    painter.drawEllipse(toScreen(vertices[extreme]), 10, 10);
+
+    QString hoverInfo;
+    HullQuery::Tangents tangents;
+    if (query.tangents(cursor, tangents)) {
+        painter.setPen(QPen(Qt::cyan, 1, Qt::DashLine));
+        painter.drawLine(m_hoverPos, toScreen(vertices[tangents.first]));
+        painter.drawLine(m_hoverPos, toScreen(vertices[tangents.second]));
+        hoverInfo = "Outside hull";
+    } else {
+        hoverInfo = "Inside hull";
+    }
+
+    painter.setPen(Qt::white);
+    painter.setFont(QFont("Arial", 10));
+    painter.drawText(m_hoverPos + QPointF(12, -8), hoverInfo);
+
+    const QString calipersInfo = QString("Diameter: %1   Width: %2   Min rect area: %3")
+                                     .arg(diameter.length, 0, 'f', 1)
+                                     .arg(query.width().length, 0, 'f', 1)
+                                     .arg(rectangle.area, 0, 'f', 1);
+    painter.drawText(width() - painter.fontMetrics().horizontalAdvance(calipersInfo) - 10,
+                     height() - 10, calipersInfo);
+}
+
+void DrawWidget::wheelEvent(QWheelEvent* event)
+{
+    const double factor = std::pow(1.0015, event->angleDelta().y());
+    const double newScale = std::clamp(m_scale * factor, MinScale, MaxScale);
+
+    // Zoom around the cursor: the world point under it stays in place.
+    const QPointF cursor = event->position();
+    const Point anchor = toWorld(cursor);
+    m_scale = newScale;
+    m_offset = QPointF(cursor.x() - anchor.x * m_scale, cursor.y() - anchor.y * m_scale);
+
+    event->accept();
+    invalidateScene();
+}
+
+void DrawWidget::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::LeftButton) {
+        m_isPanning = true;
+        m_lastMousePos = event->position();
+        setCursor(Qt::ClosedHandCursor);
     }
 }
+
+void DrawWidget::mouseMoveEvent(QMouseEvent* event)
+{
+    m_hasHover = true;
+    m_hoverPos = event->position();
+
+    if (m_isPanning) {
+        m_offset += event->position() - m_lastMousePos;
+        m_lastMousePos = event->position();
+        invalidateScene();
+    } else if (m_p_state->hullQuery().isValid()) {
+        // Without a hull there is no overlay to move.
+        update();
+    }
+}
+
+void DrawWidget::leaveEvent(QEvent*)
+{
+    m_hasHover = false;
+    if (m_p_state->hullQuery().isValid()) {
+        update();
+    }
+}
+
+void DrawWidget::mouseReleaseEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::LeftButton && m_isPanning) {
+        m_isPanning = false;
+        unsetCursor();
+    }
+}
+
+void DrawWidget::mouseDoubleClickEvent(QMouseEvent*)
+{
+    resetView();
+}
@@ -2,23 +2,78 @@
 #define DRAWWIDGET_H
 
 #include <QWidget>
+#include <QPixmap>
+#include <QPointF>
 #include "../core/AppState.h"
+#include "../geometry/QuadTree.h"
+#include "DensityRenderer.h"
+
+class QPainter;
 
 class DrawWidget : public QWidget
 {
     Q_OBJECT
 
 public:
+    enum class RenderMode {
+        Auto,
+        Points,
+        Density
+    };
+
     explicit DrawWidget(AppState* state, QWidget* parent = nullptr);
 
+    void resetView();
+    void setRenderMode(RenderMode mode);
+    void setDensityThreshold(std::size_t visiblePoints);
+    // Drops the cached scene; the next paint redraws everything under the
+    // hover overlay.
+    void invalidateScene();
+
 protected:
     void paintEvent(QPaintEvent* event) override;
+    void wheelEvent(QWheelEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    void mouseDoubleClickEvent(QMouseEvent* event) override;
+    void leaveEvent(QEvent* event) override;
 
 private slots:
     void onStateChanged();
 
+private:
+    QPointF toScreen(const Point& p) const;
+    Point toWorld(const QPointF& p) const;
+    void paintScene(QPainter& painter);
+    QuadTree::Bounds visibleWorldBounds(double marginPx) const;
+    void updateIndex();
+    void drawMarker(QPainter& painter, const Point& p, const QColor& color, int size);
+    void drawHullQueries(QPainter& painter);
+
 private:
     AppState* m_p_state;
+
+    QuadTree m_index;
+    quint64 m_indexRevision;
+
+    RenderMode m_renderMode;
+    std::size_t m_densityThreshold;
+    DensityRenderer m_densityRenderer;
+    QImage m_densityImage;
+
+    // Everything but the hover overlay, repainted only when the state or the
+    // view changes.
+    QPixmap m_sceneCache;
+    bool m_sceneDirty;
+
+    double m_scale;
+    QPointF m_offset;
+    bool m_isPanning;
+    QPointF m_lastMousePos;
+
+    bool m_hasHover;
+    QPointF m_hoverPos;
 };
 
 #endif // DRAWWIDGET_H
@@ -1,7 +1,10 @@
 #include "Mainwindow.h"
+#include "ComparisonDialog.h"
 
 #include <QAction>
+#include <QComboBox>
 #include <QMenu>
+#include <QMessageBox>
 #include <QStatusBar>
 #include <QSpinBox>
 #include <QToolBar>
@@ -9,14 +12,30 @@
 #include <QSlider>
 #include <QLabel>
 #include <QRandomGenerator>
+#include <QScreen>
+#include <QSignalBlocker>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
 {
+    // Children are deleted in creation order: the runner's thread must be
+    // done before the state takes down the thread pool it uses.
+    m_p_comparisonRunner = new ComparisonRunner(this);
+
     m_p_state = new AppState(this);
     m_p_drawWidget = new DrawWidget(m_p_state, this);
     setCentralWidget(m_p_drawWidget);
 
+    m_p_comparisonDialog = new ComparisonDialog(this);
+
+    m_p_driftTimer = new QTimer(this);
+    m_p_driftTimer->setTimerType(Qt::PreciseTimer);
+    m_p_driftTimer->setInterval(16);
+
     QToolBar* p_toolBar = addToolBar("Controls");
 
     QSpinBox* p_countBox = new QSpinBox(this);
@@ -25,6 +44,20 @@ MainWindow::MainWindow(QWidget *parent)
     p_countBox->setSuffix(" pts");
     p_toolBar->addWidget(p_countBox);
 
+    QComboBox* p_distributionBox = new QComboBox(this);
+    for (PointGenerator::Distribution distribution : PointGenerator::distributions()) {
+        p_distributionBox->addItem(PointGenerator::name(distribution),
+                                   static_cast<int>(distribution));
+    }
+    p_toolBar->addWidget(p_distributionBox);
+
+    QSpinBox* p_seedBox = new QSpinBox(this);
+    p_seedBox->setRange(0, std::numeric_limits<int>::max());
+    p_seedBox->setValue(1);
+    p_seedBox->setPrefix("seed ");
+    p_seedBox->setToolTip("The same seed always generates the same points");
+    p_toolBar->addWidget(p_seedBox);
+
     QAction* addPoint = p_toolBar->addAction("Add points");
     QAction* clear = p_toolBar->addAction("Clear");
 
@@ -33,6 +66,16 @@ MainWindow::MainWindow(QWidget *parent)
     QMenu* algoMenu = new QMenu("Algorithm", this);
     QAction* selectAndrew = algoMenu->addAction("Andrew (Monotone Chain)");
     QAction* selectGraham = algoMenu->addAction("Graham Scan");
+    QAction* selectAuto = algoMenu->addAction("Auto (sampled)");
+    selectAuto->setToolTip("Sample the points and pick the fastest strategy for them");
+    algoMenu->addSeparator();
+    QAction* dedupAction = algoMenu->addAction("Remove duplicates first");
+    dedupAction->setCheckable(true);
+    dedupAction->setToolTip("Drop repeated points in parallel before the algorithm sorts them");
+    QAction* polylineAction = algoMenu->addAction("Points form a polyline (Melkman)");
+    polylineAction->setCheckable(true);
+    polylineAction->setToolTip("Take the points in order as a simple polyline, such as the Contour "
+                               "distribution, and find its hull in linear time without sorting");
 
     QToolButton* algoButton = new QToolButton(this);
     algoButton->setText("Algorithm");
@@ -43,6 +86,12 @@ MainWindow::MainWindow(QWidget *parent)
     QMenu* stepMenu = new QMenu("Step", this);
     QAction* stepAndrew = stepMenu->addAction("Instant (Andrew)");
     QAction* stepGraham = stepMenu->addAction("Instant (Graham)");
+    QAction* stepAuto = stepMenu->addAction("Instant (Auto)");
+    stepMenu->addSeparator();
+    QAction* stepPreview = stepMenu->addAction("Preview (approximate, then exact)");
+    stepPreview->setToolTip("Show an approximate hull at once while the selected algorithm runs in the background");
+    QAction* stepLayers = stepMenu->addAction("Convex layers");
+    stepLayers->setToolTip("Peel the points into nested convex layers, each drawn in its own color");
 
     QToolButton* stepButton = new QToolButton(this);
     stepButton->setText("Instant");
@@ -50,6 +99,30 @@ MainWindow::MainWindow(QWidget *parent)
     stepButton->setPopupMode(QToolButton::InstantPopup);
     p_toolBar->addWidget(stepButton);
 
+    QAction* compareAction = p_toolBar->addAction("Compare all");
+    compareAction->setToolTip("Run every algorithm concurrently and cross-check the hulls");
+
+    QMenu* viewMenu = new QMenu("View", this);
+    QAction* renderAuto = viewMenu->addAction("Auto (density above threshold)");
+    QAction* renderPoints = viewMenu->addAction("Individual points");
+    QAction* renderDensity = viewMenu->addAction("Density");
+    viewMenu->addSeparator();
+    QAction* resetViewAction = viewMenu->addAction("Reset zoom");
+    QAction* driftAction = viewMenu->addAction("Drift points");
+    driftAction->setCheckable(true);
+    driftAction->setToolTip("Move every point slightly each frame; an instant hull follows incrementally");
+    viewMenu->addSeparator();
+    QAction* pinThreadsAction = viewMenu->addAction("Pin worker threads");
+    pinThreadsAction->setCheckable(true);
+    pinThreadsAction->setToolTip("Keep each thread pool worker on its own CPU");
+    QAction* poolStatsAction = viewMenu->addAction("Thread pool statistics");
+
+    QToolButton* viewButton = new QToolButton(this);
+    viewButton->setText("View");
+    viewButton->setMenu(viewMenu);
+    viewButton->setPopupMode(QToolButton::InstantPopup);
+    p_toolBar->addWidget(viewButton);
+
     p_toolBar->addSeparator();
 
     QAction* playAction = p_toolBar->addAction("▶ Play");
@@ -62,25 +135,55 @@ MainWindow::MainWindow(QWidget *parent)
     QLabel* speedLabel = new QLabel(" Speed: ", this);
     p_toolBar->addWidget(speedLabel);
 
+    // Logarithmic scale: slider value v means 10^(v / 100) steps per second,
+    // i.e. from 1 step/s up to 10^6 steps/s.
     QSlider* speedSlider = new QSlider(Qt::Horizontal, this);
-    speedSlider->setRange(100, 2000);
-    speedSlider->setValue(500);
+    speedSlider->setRange(0, 600);
+    speedSlider->setValue(30);
     speedSlider->setMaximumWidth(150);
     speedSlider->setToolTip("Animation speed (slower ← → faster)");
     p_toolBar->addWidget(speedSlider);
 
-    connect(addPoint, &QAction::triggered, this, [this, p_countBox](){
+    QLabel* speedValueLabel = new QLabel(this);
+    speedValueLabel->setMinimumWidth(90);
+    p_toolBar->addWidget(speedValueLabel);
+
+    QToolBar* p_timelineBar = new QToolBar("Timeline", this);
+    addToolBar(Qt::BottomToolBarArea, p_timelineBar);
+
+    QSlider* timelineSlider = new QSlider(Qt::Horizontal, this);
+    timelineSlider->setRange(0, 0);
+    timelineSlider->setToolTip("Seek to any animation step");
+    p_timelineBar->addWidget(timelineSlider);
+
+    if (const QScreen* p_screen = screen()) {
+        const double refreshRate = p_screen->refreshRate();
+        if (refreshRate > 0.0) {
+            const int frameInterval = static_cast<int>(std::lround(1000.0 / refreshRate));
+            m_p_state->setFrameInterval(frameInterval);
+            m_p_driftTimer->setInterval(std::max(frameInterval, 1));
+        }
+    }
+
+    connect(addPoint, &QAction::triggered, this, [this, p_countBox, p_distributionBox, p_seedBox](){
         const int count = p_countBox->value();
         const int w = m_p_drawWidget->width();
         const int h = m_p_drawWidget->height();
         if (w <= 0 || h <= 0)
             return;
-        for (int i = 0; i < count; ++i) {
-            Point p;
-            p.x = QRandomGenerator::global()->bounded(w);
-            p.y = QRandomGenerator::global()->bounded(h);
-            m_p_state->addPoint(p);
-        }
+
+        PointGenerator::Options options;
+        options.distribution =
+            static_cast<PointGenerator::Distribution>(p_distributionBox->currentData().toInt());
+        options.seed = static_cast<std::uint64_t>(p_seedBox->value());
+        options.maxX = w;
+        options.maxY = h;
+        options.integral = true;
+        m_p_state->generatePoints(options, count);
+
+        // Move on to the next seed so repeated clicks add different points;
+        // the box can be set back to reproduce a dataset.
+        p_seedBox->setValue(p_seedBox->value() + 1);
     });
 
     connect(clear, &QAction::triggered, this, &MainWindow::onClear);
@@ -93,6 +196,18 @@ MainWindow::MainWindow(QWidget *parent)
         m_p_state->setAlgorithm(AppState::AlgorithmType::Graham);
     });
 
+    connect(selectAuto, &QAction::triggered, this, [this]() {
+        m_p_state->setAlgorithm(AppState::AlgorithmType::Auto);
+    });
+
+    connect(dedupAction, &QAction::toggled, this, [this](bool enabled) {
+        m_p_state->setDeduplicate(enabled);
+    });
+
+    connect(polylineAction, &QAction::toggled, this, [this](bool enabled) {
+        m_p_state->setInputMode(enabled ? AppState::InputMode::Polyline : AppState::InputMode::Points);
+    });
+
     connect(stepAndrew, &QAction::triggered, this, [this]() {
         m_p_state->setAlgorithm(AppState::AlgorithmType::Andrew);
         m_p_state->step();
@@ -103,6 +218,81 @@ MainWindow::MainWindow(QWidget *parent)
         m_p_state->step();
     });
 
+    connect(stepAuto, &QAction::triggered, this, [this]() {
+        m_p_state->setAlgorithm(AppState::AlgorithmType::Auto);
+        m_p_state->step();
+    });
+
+    connect(stepPreview, &QAction::triggered, this, [this]() {
+        m_p_state->preview();
+    });
+
+    connect(stepLayers, &QAction::triggered, this, [this]() {
+        m_p_state->computeConvexLayers();
+    });
+
+    connect(compareAction, &QAction::triggered, this, [this]() {
+        if (m_p_comparisonRunner->isRunning() || m_p_state->points().size() < 3) {
+            return;
+        }
+        m_p_comparisonDialog->showRunning(m_p_state->points().size());
+        m_p_comparisonDialog->show();
+        m_p_comparisonRunner->start(m_p_state->points());
+    });
+
+    connect(m_p_comparisonRunner, &ComparisonRunner::finished,
+            m_p_comparisonDialog, &ComparisonDialog::showResults);
+
+    connect(renderAuto, &QAction::triggered, this, [this]() {
+        m_p_drawWidget->setRenderMode(DrawWidget::RenderMode::Auto);
+    });
+
+    connect(renderPoints, &QAction::triggered, this, [this]() {
+        m_p_drawWidget->setRenderMode(DrawWidget::RenderMode::Points);
+    });
+
+    connect(renderDensity, &QAction::triggered, this, [this]() {
+        m_p_drawWidget->setRenderMode(DrawWidget::RenderMode::Density);
+    });
+
+    connect(resetViewAction, &QAction::triggered, m_p_drawWidget, &DrawWidget::resetView);
+
+    connect(driftAction, &QAction::toggled, this, [this](bool enabled) {
+        if (enabled) {
+            m_p_driftTimer->start();
+        } else {
+            m_p_driftTimer->stop();
+        }
+    });
+
+    connect(m_p_driftTimer, &QTimer::timeout, this, &MainWindow::onDriftTick);
+
+    connect(pinThreadsAction, &QAction::toggled, this, [this, pinThreadsAction](bool enabled) {
+        if (m_p_comparisonRunner->isRunning()) {
+            QSignalBlocker blocker(pinThreadsAction);
+            pinThreadsAction->setChecked(!enabled);
+            return;
+        }
+        ThreadPool::Options options = m_p_state->threadPoolOptions();
+        options.affinity = enabled ? ThreadPool::Affinity::Compact : ThreadPool::Affinity::None;
+        m_p_state->setThreadPoolOptions(options);
+    });
+
+    connect(poolStatsAction, &QAction::triggered, this, [this]() {
+        const std::vector<ThreadPool::WorkerStats> stats = m_p_state->threadPoolStats();
+        QString text = QString("%1 worker(s) plus the calling thread\n\n").arg(stats.size());
+        for (std::size_t i = 0; i < stats.size(); ++i) {
+            text += QString("Worker %1: %2 tasks, %3 stolen, %4 ms busy (%5%)%6\n")
+                        .arg(i)
+                        .arg(stats[i].tasks)
+                        .arg(stats[i].steals)
+                        .arg(stats[i].busyMs, 0, 'f', 1)
+                        .arg(stats[i].utilization * 100.0, 0, 'f', 1)
+                        .arg(stats[i].cpu >= 0 ? QString(", CPU %1").arg(stats[i].cpu) : QString());
+        }
+        QMessageBox::information(this, "Thread pool", text);
+    });
+
     connect(playAction, &QAction::triggered, this, [this]() {
         m_p_state->startAnimation();
     });
@@ -119,9 +309,22 @@ MainWindow::MainWindow(QWidget *parent)
         m_p_state->stepBackward();
     });
 
-    connect(speedSlider, &QSlider::valueChanged, this, [this](int value) {
-        int speed = 2100 - value;
-        m_p_state->setAnimationSpeed(speed);
+    auto applySpeed = [this, speedValueLabel](int value) {
+        const double stepsPerSecond = std::pow(10.0, value / 100.0);
+        m_p_state->setPlaybackRate(stepsPerSecond);
+        speedValueLabel->setText(QString(" %1 steps/s").arg(stepsPerSecond, 0, 'g', 3));
+    };
+    connect(speedSlider, &QSlider::valueChanged, this, applySpeed);
+    applySpeed(speedSlider->value());
+
+    connect(timelineSlider, &QSlider::valueChanged, this, [this](int value) {
+        m_p_state->seek(value);
+    });
+
+    connect(m_p_state, &AppState::stepChanged, this, [timelineSlider](int current, int total) {
+        QSignalBlocker blocker(timelineSlider);
+        timelineSlider->setRange(0, total);
+        timelineSlider->setValue(current);
     });
 }
 
@@ -137,3 +340,19 @@ void MainWindow::onClear()
 {
     m_p_state->clear();
 }
+
+// Random walk of one pixel per frame; coordinates stay integral so the hull
+// keeps using the exact integer predicates.
+void MainWindow::onDriftTick()
+{
+    if (m_p_state->points().empty()) {
+        return;
+    }
+
+    m_driftBuffer = m_p_state->points();
+    for (Point& p : m_driftBuffer) {
+        p.x += m_driftRandom.bounded(3) - 1;
+        p.y += m_driftRandom.bounded(3) - 1;
+    }
+    m_p_state->movePoints(m_driftBuffer);
+}
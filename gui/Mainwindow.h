@@ -2,9 +2,15 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
+#include <QRandomGenerator>
+#include <QTimer>
+#include <vector>
 
 #include "../core/AppState.h"
 #include "../gui/DrawWidget.h"
+#include "../core/ComparisonRunner.h"
+
+class ComparisonDialog;
 
 class MainWindow : public QMainWindow
 {
@@ -16,6 +22,7 @@ public:
 private slots:
     void onAddPoint();
     void onClear();
+    void onDriftTick();
 
     // void onSelectAndrew();
     // void onSelectGraham();
@@ -23,5 +30,11 @@ private slots:
 private:
     AppState* m_p_state;
     DrawWidget* m_p_drawWidget;
+    ComparisonRunner* m_p_comparisonRunner;
+    ComparisonDialog* m_p_comparisonDialog;
+
+    QTimer* m_p_driftTimer;
+    QRandomGenerator m_driftRandom;
+    std::vector<Point> m_driftBuffer;
 };
 #endif // MAINWINDOW_H
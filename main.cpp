@@ -1,9 +1,333 @@
 #include "gui/Mainwindow.h"
+#include "service/HullServer.h"
+#include "algorithms/AlgorithmRegistry.h"
+#include "algorithms/AutoHull.h"
+#include "algorithms/MelkmanHull.h"
+#include "algorithms/PointDeduplicator.h"
+#include "core/ThreadPool.h"
+#include "core/PointIO.h"
+#include "geometry/PointConversion.h"
 
 #include <QApplication>
+#include <QCoreApplication>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace {
+
+bool hasArgument(int argc, char* argv[], const char* argument)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], argument) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// On Windows the GUI build has no console, so the headless modes borrow the
+// one of the shell that started them for any stream that is not redirected.
+// The shell still does not wait for the process; scripts should use the
+// ConvexHullVisualizerConsole build instead.
+void attachParentConsole()
+{
+#ifdef _WIN32
+    const bool hasOutput = GetStdHandle(STD_OUTPUT_HANDLE) != nullptr;
+    const bool hasError = GetStdHandle(STD_ERROR_HANDLE) != nullptr;
+    if ((hasOutput && hasError) || !AttachConsole(ATTACH_PARENT_PROCESS)) {
+        return;
+    }
+    if (!hasOutput) {
+        std::freopen("CONOUT$", "w", stdout);
+    }
+    if (!hasError) {
+        std::freopen("CONOUT$", "w", stderr);
+    }
+#endif
+}
+
+// Headless hull service; runs until the process is terminated.
+//
+//   ConvexHullVisualizer --serve [NAME] [--workers N] [--max-in-flight N]
+int runServer(int argc, char* argv[])
+{
+    QCoreApplication application(argc, argv);
+
+    QString name = "convex-hull";
+    int workers = 0;
+    int maxInFlight = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--serve") == 0) {
+            if (i + 1 < argc && std::strncmp(argv[i + 1], "--", 2) != 0) {
+                name = QString::fromLocal8Bit(argv[++i]);
+            }
+        } else if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            workers = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--max-in-flight") == 0 && i + 1 < argc) {
+            maxInFlight = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: %s --serve [NAME] [--workers N] [--max-in-flight N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // Requests and the parallel stages inside them share one pool. The
+    // server's own thread only parses frames, so it is not counted.
+    ThreadPool::Options poolOptions;
+    poolOptions.threads = (workers > 0 ? static_cast<unsigned>(workers)
+                                       : std::max(1u, std::thread::hardware_concurrency())) + 1;
+    ThreadPool pool(poolOptions);
+    ThreadPool::install(&pool);
+    struct Uninstall
+    {
+        ~Uninstall() { ThreadPool::install(nullptr); }
+    } uninstall;
+
+    HullServer server;
+    if (maxInFlight > 0) {
+        server.setMaxInFlight(maxInFlight);
+    }
+    if (!server.listen(name)) {
+        std::fprintf(stderr, "could not listen on %s: %s\n", qPrintable(name), qPrintable(server.errorString()));
+        return 1;
+    }
+
+    std::printf("Hull service listening on %s\n", qPrintable(name));
+    std::fflush(stdout);
+    return application.exec();
+}
+
+// Picks a registered algorithm by index or by the start of its name, such as
+// "graham". Returns -1 if nothing matches.
+int findAlgorithm(const char* key)
+{
+    const std::vector<AlgorithmInfo>& algorithms = AlgorithmRegistry::algorithms();
+
+    char* end = nullptr;
+    const long index = std::strtol(key, &end, 10);
+    if (*key != '\0' && *end == '\0') {
+        return index >= 0 && index < static_cast<long>(algorithms.size()) ? static_cast<int>(index) : -1;
+    }
+
+    for (std::size_t i = 0; i < algorithms.size(); ++i) {
+        if (algorithms[i].name.startsWith(QString::fromLocal8Bit(key), Qt::CaseInsensitive)) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+// Reads points from files or stdin and writes their hull, without a display
+// or an application object. Input and output use PointIO's line format.
+// With --polyline the points, in file order, must form a simple polyline and
+// Melkman's algorithm replaces the selected one.
+//
+//   ConvexHullVisualizer --hull [FILE|-]... [--algorithm NAME|INDEX]
+//                        [--polyline] [--threads N] [--pin-threads] [--dedup]
+//                        [--output FILE] [--csv] [--stats]
+int runBatch(int argc, char* argv[])
+{
+    std::vector<const char*> inputs;
+    const char* outputPath = nullptr;
+    int algorithm = 0;
+    unsigned threads = 1;
+    bool csv = false;
+    bool printStats = false;
+    bool dedup = false;
+    bool polyline = false;
+    ThreadPool::Options poolOptions;
+    poolOptions.threads = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--hull") == 0) {
+            continue;
+        } else if (std::strcmp(argv[i], "--algorithm") == 0 && i + 1 < argc) {
+            algorithm = findAlgorithm(argv[++i]);
+            if (algorithm < 0) {
+                std::fprintf(stderr, "unknown algorithm %s\n", argv[i]);
+                return 2;
+            }
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            const int count = std::atoi(argv[++i]);
+            threads = count > 0 ? static_cast<unsigned>(count) : std::max(1u, std::thread::hardware_concurrency());
+            poolOptions.threads = threads;
+        } else if (std::strcmp(argv[i], "--pin-threads") == 0) {
+            poolOptions.affinity = ThreadPool::Affinity::Compact;
+        } else if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else if (std::strcmp(argv[i], "--stats") == 0) {
+            printStats = true;
+        } else if (std::strcmp(argv[i], "--dedup") == 0) {
+            dedup = true;
+        } else if (std::strcmp(argv[i], "--polyline") == 0) {
+            polyline = true;
+        } else if (std::strcmp(argv[i], "-") == 0 || std::strncmp(argv[i], "--", 2) != 0) {
+            inputs.push_back(argv[i]);
+        } else {
+            std::fprintf(stderr,
+                         "usage: %s --hull [FILE|-]... [--algorithm NAME|INDEX] [--polyline] [--threads N]\n"
+                         "       [--pin-threads] [--dedup] [--output FILE] [--csv] [--stats]\n",
+                         argv[0]);
+            return 2;
+        }
+    }
+
+    // Dedup reorders the points, which would break the polyline.
+    if (polyline && dedup) {
+        std::fprintf(stderr, "--dedup cannot be combined with --polyline\n");
+        return 2;
+    }
+
+    if (inputs.empty()) {
+        inputs.push_back("-");
+    }
+
+    // Every parallel stage below runs on this pool.
+    ThreadPool pool(poolOptions);
+    ThreadPool::install(&pool);
+    struct Uninstall
+    {
+        ~Uninstall() { ThreadPool::install(nullptr); }
+    } uninstall;
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point readStart = Clock::now();
+
+    std::vector<char> text;
+    for (const char* path : inputs) {
+        const bool isStdin = std::strcmp(path, "-") == 0;
+        std::FILE* file = isStdin ? stdin : std::fopen(path, "rb");
+        if (!file) {
+            std::fprintf(stderr, "could not open %s\n", path);
+            return 1;
+        }
+        const bool ok = PointIO::readAll(file, text);
+        if (!isStdin) {
+            std::fclose(file);
+        }
+        if (!ok) {
+            std::fprintf(stderr, "could not read %s\n", path);
+            return 1;
+        }
+        // Keeps the last line of one file from running into the next.
+        if (!text.empty() && text.back() != '\n') {
+            text.push_back('\n');
+        }
+    }
+
+    const Clock::time_point parseStart = Clock::now();
+    std::vector<Point> points;
+    const PointIO::ParseStats parseStats = PointIO::parse(text.data(), text.data() + text.size(), points, threads);
+    const Clock::time_point hullStart = Clock::now();
+
+    std::unique_ptr<ConvexHullAlgorithm> p_algorithm;
+    if (polyline) {
+        p_algorithm = std::make_unique<MelkmanHull>();
+    } else {
+        p_algorithm = AlgorithmRegistry::algorithms()[algorithm].create();
+    }
+    std::vector<Point> hull;
+    std::vector<PointI> integerPoints;
+    PointDeduplicator deduplicator;
+    std::size_t duplicates = 0;
+    if (toIntegerPoints(points, integerPoints)) {
+        if (dedup) {
+            duplicates = deduplicator.run(integerPoints, integerPoints);
+        }
+        std::vector<PointI> integerHull;
+        p_algorithm->computeHullInto(integerPoints, integerHull);
+        toPoints(integerHull, hull);
+    } else {
+        if (dedup) {
+            duplicates = deduplicator.run(points, points);
+        }
+        p_algorithm->computeHullInto(points, hull);
+    }
+    const Clock::time_point hullEnd = Clock::now();
+
+    std::string output;
+    PointIO::format(hull, csv ? ',' : ' ', output);
+
+    std::FILE* outputFile = outputPath ? std::fopen(outputPath, "wb") : stdout;
+    if (!outputFile) {
+        std::fprintf(stderr, "could not open %s\n", outputPath);
+        return 1;
+    }
+    const bool written = std::fwrite(output.data(), 1, output.size(), outputFile) == output.size();
+    const bool closed = outputPath ? std::fclose(outputFile) == 0 : std::fflush(outputFile) == 0;
+    if (!written || !closed) {
+        std::fprintf(stderr, "could not write %s\n", outputPath ? outputPath : "to stdout");
+        return 1;
+    }
+
+    if (parseStats.invalidLines > 0) {
+        std::fprintf(stderr, "skipped %zu line(s) without two numbers\n", parseStats.invalidLines);
+    }
+
+    if (printStats) {
+        auto milliseconds = [](Clock::duration duration) {
+            return std::chrono::duration<double, std::milli>(duration).count();
+        };
+        const double parseMs = milliseconds(hullStart - parseStart);
+        std::fprintf(stderr,
+                     "read %.1f MB in %.3f ms\n"
+                     "parsed %zu points in %.3f ms (%.0f MB/s, %u thread(s))\n"
+                     "%s: %zu hull vertices in %.3f ms\n",
+                     text.size() / 1e6, milliseconds(parseStart - readStart),
+                     points.size(), parseMs, parseMs > 0.0 ? text.size() / 1e3 / parseMs : 0.0, threads,
+                     qPrintable(p_algorithm->name()), hull.size(), milliseconds(hullEnd - hullStart));
+        if (dedup) {
+            std::fprintf(stderr, "removed %zu duplicate point(s) before the hull\n", duplicates);
+        }
+        if (const AutoHull* p_auto = dynamic_cast<const AutoHull*>(p_algorithm.get())) {
+            std::fprintf(stderr, "auto: %s\n", qPrintable(AutoHull::describe(p_auto->lastDecision())));
+        }
+        const std::vector<ThreadPool::WorkerStats> workerStats = pool.stats();
+        for (std::size_t i = 0; i < workerStats.size(); ++i) {
+            std::fprintf(stderr, "worker %zu: %llu task(s), %llu stolen, %.3f ms busy (%.0f%%)",
+                         i, static_cast<unsigned long long>(workerStats[i].tasks),
+                         static_cast<unsigned long long>(workerStats[i].steals),
+                         workerStats[i].busyMs, workerStats[i].utilization * 100.0);
+            if (workerStats[i].cpu >= 0) {
+                std::fprintf(stderr, ", CPU %d", workerStats[i].cpu);
+            }
+            std::fprintf(stderr, "\n");
+        }
+    }
+
+    return 0;
+}
+
+} // namespace
 
 int main(int argc, char *argv[])
 {
+    if (hasArgument(argc, argv, "--hull")) {
+        attachParentConsole();
+        return runBatch(argc, argv);
+    }
+
+    if (hasArgument(argc, argv, "--serve")) {
+        attachParentConsole();
+        return runServer(argc, argv);
+    }
+
     QApplication a(argc, argv);
     MainWindow w;
     w.show();
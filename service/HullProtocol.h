@@ -0,0 +1,54 @@
+#ifndef HULLPROTOCOL_H
+#define HULLPROTOCOL_H
+
+#include <cstdint>
+#include <type_traits>
+
+#include "../geometry/Point.h"
+
+// Wire format of the hull service. Every frame is a fixed header followed by
+// `count` points as pairs of doubles, all in host byte order: the service
+// only listens on a local socket, so both ends share the machine.
+//
+//   request:  header(algorithm index, count) + input points
+//   response: header(status, count) + hull, counter-clockwise
+//
+// A client may send any number of requests without waiting. Responses carry
+// the request id and arrive in completion order, not in request order.
+namespace HullProtocol {
+
+constexpr std::uint32_t RequestMagic = 0x52484843;  // "CHHR"
+constexpr std::uint32_t ResponseMagic = 0x53484843; // "CHHS"
+
+// Larger requests are rejected and the connection is closed, since the
+// stream cannot be resynchronized without reading the payload.
+constexpr std::uint32_t MaxPointsPerFrame = 1u << 24;
+
+enum Status : std::uint32_t {
+    Ok = 0,
+    UnknownAlgorithm = 1,
+    TooManyPoints = 2
+};
+
+struct FrameHeader
+{
+    std::uint32_t magic;
+    std::uint32_t requestId;
+    // Index into AlgorithmRegistry::algorithms() for requests, a Status for
+    // responses.
+    std::uint32_t code;
+    std::uint32_t count;
+};
+
+static_assert(sizeof(FrameHeader) == 16, "FrameHeader must not be padded");
+static_assert(sizeof(Point) == 2 * sizeof(double) && std::is_trivially_copyable<Point>::value,
+              "Points are sent as raw pairs of doubles");
+
+inline constexpr std::size_t payloadBytes(std::uint32_t count)
+{
+    return static_cast<std::size_t>(count) * sizeof(Point);
+}
+
+} // namespace HullProtocol
+
+#endif // HULLPROTOCOL_H
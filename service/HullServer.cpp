@@ -0,0 +1,172 @@
+#include "HullServer.h"
+#include "../algorithms/AlgorithmRegistry.h"
+#include "../geometry/PointConversion.h"
+
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QPointer>
+
+#include <algorithm>
+#include <memory>
+
+namespace {
+constexpr int DefaultMaxInFlight = 64;
+}
+
+HullServer::HullServer(QObject* parent)
+    :   QObject(parent),
+    m_p_server(new QLocalServer(this)),
+    m_maxInFlight(DefaultMaxInFlight)
+{
+    connect(m_p_server, &QLocalServer::newConnection, this, &HullServer::onNewConnection);
+}
+
+// Finished jobs post their replies to this object, so they must all be done
+// before it goes away.
+HullServer::~HullServer()
+{
+    m_requests.wait();
+}
+
+bool HullServer::listen(const QString& name)
+{
+    QLocalServer::removeServer(name);
+    return m_p_server->listen(name);
+}
+
+QString HullServer::errorString() const
+{
+    return m_p_server->errorString();
+}
+
+HullServer::Stats HullServer::stats() const
+{
+    return m_stats;
+}
+
+void HullServer::setMaxInFlight(int maxInFlight)
+{
+    m_maxInFlight = std::max(maxInFlight, 1);
+}
+
+void HullServer::onNewConnection()
+{
+    while (QLocalSocket* p_socket = m_p_server->nextPendingConnection()) {
+        m_connections.insert(p_socket, Connection());
+        ++m_stats.connections;
+
+        connect(p_socket, &QLocalSocket::readyRead, this, [this, p_socket]() {
+            readFrames(p_socket);
+        });
+        connect(p_socket, &QLocalSocket::disconnected, this, [this, p_socket]() {
+            m_connections.remove(p_socket);
+            p_socket->deleteLater();
+        });
+    }
+}
+
+// Takes every complete frame out of the socket buffer, up to the in-flight
+// limit. A partial frame is left where it is until more data arrives.
+void HullServer::readFrames(QLocalSocket* p_socket)
+{
+    const std::size_t algorithmCount = AlgorithmRegistry::algorithms().size();
+
+    while (m_connections.contains(p_socket) && m_connections[p_socket].inFlight < m_maxInFlight) {
+        HullProtocol::FrameHeader header;
+        if (p_socket->peek(reinterpret_cast<char*>(&header), sizeof(header)) < qint64(sizeof(header))) {
+            return;
+        }
+
+        if (header.magic != HullProtocol::RequestMagic || header.count > HullProtocol::MaxPointsPerFrame) {
+            ++m_stats.rejected;
+            if (header.magic == HullProtocol::RequestMagic) {
+                reply(p_socket, header.requestId, HullProtocol::TooManyPoints, {});
+            }
+            m_connections.remove(p_socket);
+            p_socket->disconnectFromServer();
+            return;
+        }
+
+        const qint64 frameBytes = sizeof(header) + HullProtocol::payloadBytes(header.count);
+        if (p_socket->bytesAvailable() < frameBytes) {
+            return;
+        }
+
+        p_socket->read(reinterpret_cast<char*>(&header), sizeof(header));
+        std::vector<Point> points(header.count);
+        p_socket->read(reinterpret_cast<char*>(points.data()), HullProtocol::payloadBytes(header.count));
+
+        if (header.code >= algorithmCount) {
+            ++m_stats.rejected;
+            reply(p_socket, header.requestId, HullProtocol::UnknownAlgorithm, {});
+            continue;
+        }
+
+        submit(p_socket, header, std::move(points));
+    }
+}
+
+void HullServer::submit(QLocalSocket* p_socket, const HullProtocol::FrameHeader& header, std::vector<Point> points)
+{
+    ++m_stats.requests;
+    ++m_connections[p_socket].inFlight;
+
+    const QPointer<QLocalSocket> p_target(p_socket);
+    const std::uint32_t requestId = header.requestId;
+    const std::uint32_t algorithm = header.code;
+
+    m_requests.run([this, p_target, requestId, algorithm, points = std::move(points)]() {
+        std::vector<Point> hull = computeHull(algorithm, points);
+
+        QMetaObject::invokeMethod(this, [this, p_target, requestId, hull = std::move(hull)]() {
+            // The client may have disconnected while the hull was computed.
+            if (!p_target || !m_connections.contains(p_target.data())) {
+                return;
+            }
+            --m_connections[p_target.data()].inFlight;
+            reply(p_target.data(), requestId, HullProtocol::Ok, hull);
+            readFrames(p_target.data());
+        }, Qt::QueuedConnection);
+    });
+}
+
+void HullServer::reply(QLocalSocket* p_socket, std::uint32_t requestId, std::uint32_t status,
+                       const std::vector<Point>& hull)
+{
+    HullProtocol::FrameHeader header;
+    header.magic = HullProtocol::ResponseMagic;
+    header.requestId = requestId;
+    header.code = status;
+    header.count = static_cast<std::uint32_t>(hull.size());
+
+    p_socket->write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!hull.empty()) {
+        p_socket->write(reinterpret_cast<const char*>(hull.data()), HullProtocol::payloadBytes(header.count));
+    }
+}
+
+// Algorithms keep their scratch buffers between calls and are not thread
+// safe, so every pool thread has its own instances.
+std::vector<Point> HullServer::computeHull(std::uint32_t algorithm, const std::vector<Point>& points)
+{
+    thread_local std::vector<std::unique_ptr<ConvexHullAlgorithm>> algorithms;
+    thread_local std::vector<PointI> integerPoints;
+    thread_local std::vector<PointI> integerHull;
+
+    const std::vector<AlgorithmInfo>& registry = AlgorithmRegistry::algorithms();
+    if (algorithms.empty()) {
+        algorithms.resize(registry.size());
+    }
+    if (!algorithms[algorithm]) {
+        algorithms[algorithm] = registry[algorithm].create();
+    }
+
+    std::vector<Point> hull;
+    if (toIntegerPoints(points, integerPoints)) {
+        algorithms[algorithm]->computeHullInto(integerPoints, integerHull);
+        toPoints(integerHull, hull);
+    } else {
+        algorithms[algorithm]->computeHullInto(points, hull);
+    }
+    return hull;
+}
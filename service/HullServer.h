@@ -0,0 +1,69 @@
+#ifndef HULLSERVER_H
+#define HULLSERVER_H
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <vector>
+
+#include "../core/ThreadPool.h"
+#include "../geometry/Point.h"
+#include "HullProtocol.h"
+
+class QLocalServer;
+class QLocalSocket;
+
+// Headless hull service on a QLocalServer. Frames are parsed on the thread
+// that owns the server and the hulls are computed on the global ThreadPool,
+// so one connection can keep many requests in flight and the parallel stages
+// inside a hull share the same threads. The pool needs at least one worker
+// besides the server's thread. See HullProtocol.h for the wire format.
+class HullServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stats
+    {
+        quint64 connections = 0;
+        quint64 requests = 0;
+        quint64 rejected = 0;
+    };
+
+    explicit HullServer(QObject* parent = nullptr);
+    ~HullServer() override;
+
+    // Removes a stale socket of the same name left behind by a crashed server.
+    bool listen(const QString& name);
+    QString errorString() const;
+    Stats stats() const;
+
+    // Requests a single connection may have queued on the pool. Further
+    // frames stay in the socket buffer until some of them complete.
+    void setMaxInFlight(int maxInFlight);
+
+private slots:
+    void onNewConnection();
+
+private:
+    struct Connection
+    {
+        int inFlight = 0;
+    };
+
+    void readFrames(QLocalSocket* p_socket);
+    void submit(QLocalSocket* p_socket, const HullProtocol::FrameHeader& header, std::vector<Point> points);
+    void reply(QLocalSocket* p_socket, std::uint32_t requestId, std::uint32_t status,
+               const std::vector<Point>& hull);
+
+    static std::vector<Point> computeHull(std::uint32_t algorithm, const std::vector<Point>& points);
+
+private:
+    QLocalServer* m_p_server;
+    ThreadPool::TaskGroup m_requests;
+    QHash<QLocalSocket*, Connection> m_connections;
+    int m_maxInFlight;
+    Stats m_stats;
+};
+
+#endif // HULLSERVER_H
@@ -0,0 +1,272 @@
+#include "algorithms/AlgorithmRegistry.h"
+#include "algorithms/BatchHull.h"
+#include "algorithms/MelkmanHull.h"
+#include "algorithms/PointDeduplicator.h"
+#include "core/PointGenerator.h"
+#include "geometry/PointConversion.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Timed runs of every registered algorithm and of BatchHull on fixed,
+// seeded datasets. Each case reports the median of several runs and is
+// compared against a stored baseline; the executable fails if a case got
+// slower than baseline * (1 + threshold).
+//
+//   HullBenchmark [--baseline FILE] [--threshold FRACTION] [--update-baseline]
+//
+// Baselines depend on the machine. Regenerate them with --update-baseline on
+// the machine that runs the suite; a missing baseline file is written
+// instead of compared against.
+
+namespace {
+
+constexpr int WarmupRuns = 1;
+constexpr int MeasuredRuns = 7;
+// Differences below this are timer and scheduler noise, whatever the ratio.
+constexpr double NoiseFloorMs = 0.5;
+
+struct Options
+{
+    std::string baselinePath = "benchmark_baseline.txt";
+    double threshold = 0.30;
+    bool updateBaseline = false;
+};
+
+struct Case
+{
+    std::string name;
+    std::function<void()> run;
+};
+
+double medianMilliseconds(const std::function<void()>& run)
+{
+    for (int i = 0; i < WarmupRuns; ++i) {
+        run();
+    }
+
+    std::vector<double> samples;
+    for (int i = 0; i < MeasuredRuns; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+std::vector<Point> dataset(PointGenerator::Distribution distribution, std::size_t count)
+{
+    PointGenerator::Options options;
+    options.distribution = distribution;
+    options.seed = 20240601;
+    options.maxX = 1 << 20;
+    options.maxY = 1 << 20;
+    options.integral = true;
+    return PointGenerator::generate(options, count);
+}
+
+// name -> milliseconds. Lines are "<name> <milliseconds>"; the name may
+// contain spaces, '#' starts a comment.
+bool readBaseline(const std::string& path, std::map<std::string, double>& baseline)
+{
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        const std::size_t split = line.find_last_of(' ');
+        if (split == std::string::npos) {
+            continue;
+        }
+        baseline[line.substr(0, split)] = std::atof(line.c_str() + split + 1);
+    }
+    return true;
+}
+
+bool writeBaseline(const std::string& path, const std::vector<std::pair<std::string, double>>& results)
+{
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+
+    out << "# Median milliseconds per case, written by HullBenchmark --update-baseline.\n";
+    for (const auto& result : results) {
+        std::ostringstream value;
+        value.precision(3);
+        value << std::fixed << result.second;
+        out << result.first << ' ' << value.str() << '\n';
+    }
+    return true;
+}
+
+bool parseArguments(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            options.baselinePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            options.threshold = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--update-baseline") == 0) {
+            options.updateBaseline = true;
+        } else {
+            std::fprintf(stderr,
+                         "usage: %s [--baseline FILE] [--threshold FRACTION] [--update-baseline]\n",
+                         argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        return 2;
+    }
+
+    const std::vector<std::pair<std::string, std::vector<Point>>> datasets = {
+        {"uniform 1M", dataset(PointGenerator::Distribution::Uniform, 1000000)},
+        {"circle 200k", dataset(PointGenerator::Distribution::Circle, 200000)},
+        {"clusters 1M", dataset(PointGenerator::Distribution::GaussianClusters, 1000000)},
+        {"collinear 1M", dataset(PointGenerator::Distribution::Collinear, 1000000)},
+        {"contour 1M", dataset(PointGenerator::Distribution::Contour, 1000000)},
+    };
+
+    std::vector<std::unique_ptr<ConvexHullAlgorithm>> algorithms;
+    std::vector<Case> cases;
+    std::vector<Point> hull;
+    std::vector<PointI> hullI;
+
+    for (const AlgorithmInfo& info : AlgorithmRegistry::algorithms()) {
+        algorithms.push_back(info.create());
+        ConvexHullAlgorithm* algorithm = algorithms.back().get();
+        const std::string name = info.name.toStdString();
+
+        for (const auto& entry : datasets) {
+            const std::vector<Point>* points = &entry.second;
+            cases.push_back({name + " | " + entry.first,
+                             [algorithm, points, &hull] { algorithm->computeHullInto(*points, hull); }});
+
+            auto pointsI = std::make_shared<std::vector<PointI>>();
+            toIntegerPoints(*points, *pointsI);
+            cases.push_back({name + " | " + entry.first + " integer",
+                             [algorithm, pointsI, &hullI] { algorithm->computeHullInto(*pointsI, hullI); }});
+        }
+    }
+
+    PointSetsI smallSets;
+    const std::vector<PointI> smallPoints =
+        toIntegerPointsUnchecked(dataset(PointGenerator::Distribution::Uniform, 12 * 100000));
+    for (std::size_t i = 0; i < smallPoints.size(); i += 12) {
+        smallSets.append(smallPoints.data() + i, smallPoints.data() + i + 12);
+    }
+    BatchHull batch;
+    PointSetsI batchOutput;
+    cases.push_back({"BatchHull | 100k sets of 12 integer",
+                     [&] { batch.compute(smallSets, batchOutput); }});
+
+    // What the window generates: 1M random pixels on a 1920x1080 canvas, a
+    // fifth of them repeats. The hull alone, then with dedup in front of it.
+    PointGenerator::Options canvasOptions;
+    canvasOptions.seed = 20240601;
+    canvasOptions.maxX = 1920;
+    canvasOptions.maxY = 1080;
+    canvasOptions.integral = true;
+    auto canvasPoints = std::make_shared<std::vector<PointI>>();
+    toIntegerPoints(PointGenerator::generate(canvasOptions, 1000000), *canvasPoints);
+    auto uniquePoints = std::make_shared<std::vector<PointI>>();
+    auto deduplicator = std::make_shared<PointDeduplicator>();
+    for (const std::unique_ptr<ConvexHullAlgorithm>& algorithm : algorithms) {
+        ConvexHullAlgorithm* p_algorithm = algorithm.get();
+        const std::string name = p_algorithm->name().toStdString();
+        cases.push_back({name + " | canvas 1M integer",
+                         [p_algorithm, canvasPoints, &hullI] { p_algorithm->computeHullInto(*canvasPoints, hullI); }});
+        cases.push_back({name + " | canvas 1M integer dedup",
+                         [p_algorithm, canvasPoints, uniquePoints, deduplicator, &hullI] {
+                             deduplicator->run(*canvasPoints, *uniquePoints);
+                             p_algorithm->computeHullInto(*uniquePoints, hullI);
+                         }});
+    }
+
+    // The contour is a simple polyline, so Melkman can take it in order; the
+    // registered algorithms above sort the same points.
+    auto melkman = std::make_shared<MelkmanHull>();
+    for (const auto& entry : datasets) {
+        if (entry.first != "contour 1M") {
+            continue;
+        }
+        const std::vector<Point>* points = &entry.second;
+        cases.push_back({"Melkman (polyline) | contour 1M",
+                         [melkman, points, &hull] { melkman->computeHullInto(*points, hull); }});
+
+        auto pointsI = std::make_shared<std::vector<PointI>>();
+        toIntegerPoints(*points, *pointsI);
+        cases.push_back({"Melkman (polyline) | contour 1M integer",
+                         [melkman, pointsI, &hullI] { melkman->computeHullInto(*pointsI, hullI); }});
+    }
+
+    std::map<std::string, double> baseline;
+    const bool haveBaseline = !options.updateBaseline && readBaseline(options.baselinePath, baseline);
+
+    std::vector<std::pair<std::string, double>> results;
+    int regressions = 0;
+
+    for (const Case& benchmark : cases) {
+        const double ms = medianMilliseconds(benchmark.run);
+        results.emplace_back(benchmark.name, ms);
+
+        const auto it = baseline.find(benchmark.name);
+        if (!haveBaseline || it == baseline.end()) {
+            std::printf("%-50s %10.3f ms  (no baseline)\n", benchmark.name.c_str(), ms);
+            continue;
+        }
+
+        const double limit = it->second * (1.0 + options.threshold);
+        const bool regressed = ms > limit && ms - it->second > NoiseFloorMs;
+        regressions += regressed;
+        std::printf("%-50s %10.3f ms  baseline %10.3f ms  %+6.1f%%%s\n",
+                    benchmark.name.c_str(), ms, it->second,
+                    100.0 * (ms / it->second - 1.0), regressed ? "  REGRESSION" : "");
+    }
+
+    if (!haveBaseline) {
+        if (!writeBaseline(options.baselinePath, results)) {
+            std::fprintf(stderr, "could not write baseline %s\n", options.baselinePath.c_str());
+            return 2;
+        }
+        std::printf("Wrote baseline %s\n", options.baselinePath.c_str());
+        return 0;
+    }
+
+    if (regressions > 0) {
+        std::printf("%d case(s) slower than baseline by more than %.0f%%\n",
+                    regressions, 100.0 * options.threshold);
+        return 1;
+    }
+
+    std::printf("No regressions (threshold %.0f%%)\n", 100.0 * options.threshold);
+    return 0;
+}
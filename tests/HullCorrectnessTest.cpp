@@ -0,0 +1,684 @@
+#include "TestSupport.h"
+
+#include "algorithms/AlgorithmRegistry.h"
+#include "algorithms/ApproximateHull.h"
+#include "algorithms/AutoHull.h"
+#include "algorithms/BatchHull.h"
+#include "algorithms/ConvexLayers.h"
+#include "algorithms/HullSummary.h"
+#include "algorithms/KineticHull.h"
+#include "algorithms/MelkmanHull.h"
+#include "algorithms/MonotoneChain.h"
+#include "algorithms/PointDeduplicator.h"
+#include "core/PointGenerator.h"
+#include "geometry/PointConversion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Dataset
+{
+    std::string label;
+    std::vector<Point> points;
+};
+
+std::vector<Point> repeated(const Point& p, int count)
+{
+    return std::vector<Point>(count, p);
+}
+
+// Hand-picked inputs for the paths that randomized data rarely reaches:
+// repeated points, collinear sets in every direction, copies of the lowest
+// point (Graham's pivot) and points on hull edges.
+std::vector<Dataset> degenerateDatasets()
+{
+    std::vector<Dataset> sets;
+
+    sets.push_back({"empty", {}});
+    sets.push_back({"single", {Point(3, 4)}});
+    sets.push_back({"two identical", repeated(Point(3, 4), 2)});
+    sets.push_back({"three identical", repeated(Point(3, 4), 3)});
+    sets.push_back({"many identical", repeated(Point(-7, 11), 50)});
+    sets.push_back({"two distinct", {Point(5, 1), Point(1, 5)}});
+    sets.push_back({"two distinct repeated",
+                    {Point(5, 1), Point(1, 5), Point(5, 1), Point(1, 5), Point(5, 1)}});
+
+    std::vector<Point> horizontal;
+    std::vector<Point> vertical;
+    std::vector<Point> diagonal;
+    std::vector<Point> antiDiagonal;
+    for (int i = 0; i < 20; ++i) {
+        horizontal.emplace_back((i * 7) % 20, 3);
+        vertical.emplace_back(-2, (i * 7) % 20);
+        diagonal.emplace_back((i * 7) % 20, (i * 7) % 20);
+        antiDiagonal.emplace_back((i * 7) % 20, 40 - 2 * ((i * 7) % 20));
+    }
+    sets.push_back({"collinear horizontal", horizontal});
+    sets.push_back({"collinear vertical", vertical});
+    sets.push_back({"collinear diagonal", diagonal});
+    sets.push_back({"collinear anti-diagonal", antiDiagonal});
+
+    std::vector<Point> collinearRepeated = diagonal;
+    collinearRepeated.insert(collinearRepeated.end(), diagonal.begin(), diagonal.end());
+    collinearRepeated.insert(collinearRepeated.end(), 10, Point(0, 0));
+    sets.push_back({"collinear with duplicates", collinearRepeated});
+
+    std::vector<Point> pivotCopies = {Point(0, 0), Point(10, 0), Point(10, 10), Point(0, 10)};
+    pivotCopies.insert(pivotCopies.end(), 5, Point(0, 0));
+    pivotCopies.push_back(Point(5, 5));
+    sets.push_back({"pivot duplicates", pivotCopies});
+
+    sets.push_back({"pivot duplicates only",
+                    {Point(0, 0), Point(0, 0), Point(0, 0), Point(4, 9)}});
+
+    std::vector<Point> edgePoints;
+    for (int i = 0; i <= 10; ++i) {
+        edgePoints.emplace_back(i, 0);
+        edgePoints.emplace_back(10, i);
+        edgePoints.emplace_back(10 - i, 10);
+        edgePoints.emplace_back(0, 10 - i);
+        edgePoints.emplace_back(i, i);
+    }
+    sets.push_back({"square with edge points", edgePoints});
+
+    std::vector<Point> lastRay = {Point(0, 0), Point(10, 0), Point(5, 5)};
+    for (int i = 1; i <= 6; ++i) {
+        lastRay.emplace_back(i, i);
+    }
+    sets.push_back({"collinear closing edge", lastRay});
+
+    // Corners at the edge of the integer kernel's range, placed so that the
+    // double predicates stay exact too.
+    const double big = IntegerKernelLimit - 1048576.0;
+    sets.push_back({"kernel limits",
+                    {Point(-IntegerKernelLimit, -IntegerKernelLimit), Point(big, -IntegerKernelLimit),
+                     Point(big, big), Point(-IntegerKernelLimit, big), Point(0, 0),
+                     Point(big, big), Point(-IntegerKernelLimit, 0)}});
+
+    return sets;
+}
+
+// Random integral inputs. Small ranges produce plenty of duplicate and
+// collinear points; the large range exercises ordinary positions.
+std::vector<Dataset> randomizedDatasets()
+{
+    std::vector<Dataset> sets;
+    const std::size_t sizes[] = {3, 4, 5, 8, 13, 32, 100};
+    const double ranges[] = {4.0, 64.0, 1.0e6};
+
+    for (PointGenerator::Distribution distribution : PointGenerator::distributions()) {
+        for (std::size_t n : sizes) {
+            for (double range : ranges) {
+                for (std::uint64_t seed = 1; seed <= 8; ++seed) {
+                    PointGenerator::Options options;
+                    options.distribution = distribution;
+                    options.seed = seed * 7919 + n;
+                    options.minX = -range;
+                    options.minY = -range / 2;
+                    options.maxX = range;
+                    options.maxY = range;
+                    options.integral = true;
+                    options.clusterCount = 3;
+
+                    sets.push_back({std::string(PointGenerator::name(distribution)) +
+                                        " n=" + std::to_string(n) +
+                                        " range=" + std::to_string(static_cast<long long>(range)) +
+                                        " seed=" + std::to_string(seed),
+                                    PointGenerator::generate(options, n)});
+                }
+            }
+        }
+    }
+
+    return sets;
+}
+
+void checkAlgorithms(const std::vector<Dataset>& datasets)
+{
+    for (const AlgorithmInfo& info : AlgorithmRegistry::algorithms()) {
+        std::unique_ptr<ConvexHullAlgorithm> algorithm = info.create();
+        const std::string name = info.name.toStdString();
+
+        std::vector<Point> hull;
+        std::vector<PointI> hullI;
+        std::vector<PointI> pointsI;
+
+        for (const Dataset& dataset : datasets) {
+            const std::string context = name + " on " + dataset.label;
+            std::string error;
+
+            CHECK(isExactHull(dataset.points, algorithm->computeHull(dataset.points), error),
+                  context + ": " + error);
+
+            // The Into variants reuse buffers left over from the previous set.
+            algorithm->computeHullInto(dataset.points, hull);
+            CHECK(isExactHull(dataset.points, hull, error), context + " (into): " + error);
+
+            CHECK(toIntegerPoints(dataset.points, pointsI), context + ": not integral");
+            algorithm->computeHullInto(pointsI, hullI);
+            CHECK(isExactHull(pointsI, hullI, error), context + " (integer): " + error);
+
+            if (dataset.points.size() <= 200) {
+                const std::vector<AnimationStep> steps = algorithm->generateSteps(dataset.points);
+                CHECK(!steps.empty() && steps.back().type == AnimationStep::FINAL_HULL,
+                      context + ": animation does not end with the final hull");
+            }
+        }
+    }
+}
+
+template<typename T>
+void checkBatch(const std::vector<Dataset>& datasets)
+{
+    BasicPointSets<T> input;
+    std::vector<std::vector<BasicPoint<T>>> sources;
+
+    for (const Dataset& dataset : datasets) {
+        std::vector<BasicPoint<T>> points;
+        for (const Point& p : dataset.points) {
+            points.emplace_back(static_cast<T>(p.x), static_cast<T>(p.y));
+        }
+        input.append(points.data(), points.data() + points.size());
+        sources.push_back(std::move(points));
+    }
+
+    BatchHull batch;
+    BasicPointSets<T> output;
+    batch.compute(input, output);
+
+    CHECK(output.size() == datasets.size(), "batch returned a different number of sets");
+    if (output.size() != datasets.size()) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < datasets.size(); ++i) {
+        const std::vector<BasicPoint<T>> hull(output.points.begin() + output.offsets[i],
+                                              output.points.begin() + output.offsets[i + 1]);
+        std::string error;
+        CHECK(isExactHull(sources[i], hull, error),
+              "BatchHull on " + datasets[i].label + ": " + error);
+    }
+}
+
+// Random walks of a few units per update, with an occasional large jump, so
+// that both the warm path and the fallback are exercised.
+void checkKinetic(const std::vector<Dataset>& datasets)
+{
+    std::mt19937 random(7);
+
+    for (const Dataset& dataset : datasets) {
+        if (dataset.points.size() > 100) {
+            continue;
+        }
+
+        KineticHull kinetic;
+        std::vector<Point> points = dataset.points;
+        for (int frame = 0; frame < 12; ++frame) {
+            const int step = frame == 8 ? 1000 : 2;
+            for (Point& p : points) {
+                p.x += static_cast<int>(random() % (2 * step + 1)) - step;
+                p.y += static_cast<int>(random() % (2 * step + 1)) - step;
+            }
+
+            std::string error;
+            CHECK(isExactHull(points, kinetic.update(points), error),
+                  "KineticHull on " + dataset.label + " frame " + std::to_string(frame) + ": " + error);
+        }
+    }
+}
+
+double distanceToSegment(const Point& p, const Point& a, const Point& b)
+{
+    const double dx = b.x - a.x;
+    const double dy = b.y - a.y;
+    const double lengthSquared = dx * dx + dy * dy;
+    double t = lengthSquared > 0.0 ? ((p.x - a.x) * dx + (p.y - a.y) * dy) / lengthSquared : 0.0;
+    t = std::clamp(t, 0.0, 1.0);
+    return std::hypot(p.x - (a.x + t * dx), p.y - (a.y + t * dy));
+}
+
+// The approximation lies inside the exact hull, so the Hausdorff distance is
+// the largest distance from an exact vertex to the approximate boundary.
+// Filtering by the approximation must not lose any exact vertex.
+void checkApproximate(const std::vector<Dataset>& datasets)
+{
+    const std::unique_ptr<ConvexHullAlgorithm> exact = AlgorithmRegistry::algorithms().front().create();
+
+    for (int directions : {8, 64}) {
+        ApproximateHull approximate(directions);
+
+        for (const Dataset& dataset : datasets) {
+            const std::string label = "ApproximateHull(" + std::to_string(directions) + ") on " + dataset.label;
+
+            std::vector<Point> hull;
+            approximate.compute(dataset.points, hull);
+
+            bool verticesFromInput = true;
+            for (const Point& v : hull) {
+                verticesFromInput = verticesFromInput &&
+                    std::any_of(dataset.points.begin(), dataset.points.end(),
+                                [&](const Point& p) { return samePoint(p, v); });
+            }
+            CHECK(verticesFromInput, label + ": vertex is not an input point");
+
+            const std::vector<Point> expected = bruteForceHull(dataset.points);
+            double hausdorff = 0.0;
+            for (const Point& v : expected) {
+                double distance = hull.empty() ? 0.0 : distanceToSegment(v, hull[0], hull[0]);
+                for (std::size_t i = 0; i < hull.size(); ++i) {
+                    distance = std::min(distance, distanceToSegment(v, hull[i], hull[(i + 1) % hull.size()]));
+                }
+                hausdorff = std::max(hausdorff, distance);
+            }
+            CHECK(hausdorff <= approximate.errorBound() * (1.0 + 1e-9) + 1e-9,
+                  label + ": Hausdorff distance " + std::to_string(hausdorff) +
+                  " exceeds the bound " + std::to_string(approximate.errorBound()));
+
+            std::vector<Point> candidates;
+            approximate.collectCandidates(dataset.points, candidates);
+            std::string error;
+            CHECK(isExactHull(dataset.points, exact->computeHull(candidates), error),
+                  label + " candidates: " + error);
+        }
+    }
+}
+
+// Reference peeling: a point is on the boundary of the hull of the
+// remaining points if a line through it and some other remaining point has
+// all of them on one side.
+std::vector<std::uint32_t> bruteForceDepths(const std::vector<Point>& points)
+{
+    std::vector<std::uint32_t> depths(points.size(), 0);
+    std::vector<std::size_t> remaining(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        remaining[i] = i;
+    }
+
+    for (std::uint32_t depth = 0; !remaining.empty(); ++depth) {
+        std::vector<std::size_t> inner;
+        for (std::size_t i : remaining) {
+            const Point& r = points[i];
+            bool onBoundary = true;
+            for (std::size_t j : remaining) {
+                if (samePoint(points[j], r)) {
+                    continue;
+                }
+                onBoundary = false;
+                int left = 0;
+                int right = 0;
+                for (std::size_t k : remaining) {
+                    const double value = cross(r, points[j], points[k]);
+                    left += value > 0;
+                    right += value < 0;
+                }
+                if (left == 0 || right == 0) {
+                    onBoundary = true;
+                    break;
+                }
+            }
+
+            if (onBoundary) {
+                depths[i] = depth;
+            } else {
+                inner.push_back(i);
+            }
+        }
+        remaining.swap(inner);
+    }
+    return depths;
+}
+
+void checkConvexLayers(const std::vector<Dataset>& datasets)
+{
+    ConvexLayers layers;
+    for (const Dataset& dataset : datasets) {
+        if (dataset.points.size() > 100) {
+            continue;
+        }
+
+        layers.compute(dataset.points);
+        CHECK(layers.depths() == bruteForceDepths(dataset.points), "ConvexLayers on " + dataset.label);
+
+        std::size_t boundaryPoints = 0;
+        for (std::size_t i = 0; i < layers.layerCount(); ++i) {
+            boundaryPoints += layers.layer(i).size();
+        }
+        CHECK(dataset.points.empty() == (layers.layerCount() == 0) && boundaryPoints <= 2 * dataset.points.size(),
+              "ConvexLayers boundaries on " + dataset.label);
+    }
+}
+
+// Shards of every size from one point to the whole set, each summarized by
+// a different algorithm, shipped through serialize() and merged pairwise.
+void checkSummaries(const std::vector<Dataset>& datasets)
+{
+    const std::vector<AlgorithmInfo>& algorithms = AlgorithmRegistry::algorithms();
+
+    for (const Dataset& dataset : datasets) {
+        for (std::size_t shardCount : {1, 2, 3, 7}) {
+            const std::string label = "HullSummary on " + dataset.label + " with " + std::to_string(shardCount) + " shards";
+
+            std::string wire;
+            for (std::size_t shard = 0; shard < shardCount; ++shard) {
+                std::vector<Point> points;
+                for (std::size_t i = shard; i < dataset.points.size(); i += shardCount) {
+                    points.push_back(dataset.points[i]);
+                }
+                const std::unique_ptr<ConvexHullAlgorithm> algorithm = algorithms[shard % algorithms.size()].create();
+                HullSummary::fromHull(algorithm->computeHull(points), points.size()).serialize(wire);
+            }
+
+            std::vector<HullSummary> summaries;
+            std::size_t offset = 0;
+            while (offset < wire.size()) {
+                HullSummary summary;
+                const std::size_t used = HullSummary::deserialize(wire.data() + offset, wire.size() - offset, summary);
+                if (used == 0) {
+                    break;
+                }
+                summaries.push_back(summary);
+                offset += used;
+            }
+            CHECK(summaries.size() == shardCount, label + ": deserialization failed");
+            if (summaries.size() != shardCount) {
+                continue;
+            }
+
+            while (summaries.size() > 1) {
+                std::vector<HullSummary> next;
+                for (std::size_t i = 0; i + 1 < summaries.size(); i += 2) {
+                    next.push_back(HullSummary::merge(summaries[i], summaries[i + 1]));
+                }
+                if (summaries.size() % 2 == 1) {
+                    next.push_back(summaries.back());
+                }
+                summaries.swap(next);
+            }
+
+            std::string error;
+            CHECK(isExactHull(dataset.points, summaries[0].hull(), error), label + ": " + error);
+            CHECK(summaries[0].pointCount() == dataset.points.size(), label + ": wrong point count");
+        }
+    }
+
+    HullSummary summary;
+    std::string valid;
+    HullSummary::fromHull({Point(0, 0), Point(4, 0), Point(0, 4)}, 3).serialize(valid);
+    CHECK(HullSummary::deserialize(valid.data(), valid.size() - 1, summary) == 0, "truncated summary accepted");
+
+    std::string clockwise;
+    HullSummary::fromHull({Point(0, 0), Point(0, 4), Point(4, 0)}, 3).serialize(clockwise);
+    CHECK(HullSummary::deserialize(clockwise.data(), clockwise.size(), summary) == 0, "clockwise summary accepted");
+}
+
+template<typename T>
+std::set<std::pair<T, T>> pointSet(const std::vector<BasicPoint<T>>& points)
+{
+    std::set<std::pair<T, T>> set;
+    for (const BasicPoint<T>& p : points) {
+        set.insert({p.x, p.y});
+    }
+    return set;
+}
+
+template<typename T>
+void checkDeduplicated(PointDeduplicator& deduplicator, const std::vector<BasicPoint<T>>& points,
+                       const std::string& label)
+{
+    std::vector<BasicPoint<T>> unique;
+    const std::size_t removed = deduplicator.run(points, unique);
+    const std::set<std::pair<T, T>> expected = pointSet(points);
+    CHECK(unique.size() == expected.size() && pointSet(unique) == expected && removed == points.size() - unique.size(),
+          "PointDeduplicator on " + label);
+
+    // In place, as AppState runs it on its integer buffer.
+    std::vector<BasicPoint<T>> inPlace = points;
+    CHECK(deduplicator.run(inPlace, inPlace) == removed && pointSet(inPlace) == expected,
+          "PointDeduplicator in place on " + label);
+}
+
+// The small sets take the sequential path; the large ones are above the
+// threshold for the partitioned one.
+void checkDeduplication(const std::vector<Dataset>& datasets)
+{
+    PointDeduplicator deduplicator;
+    const std::unique_ptr<ConvexHullAlgorithm> algorithm = AlgorithmRegistry::algorithms().front().create();
+
+    std::vector<Dataset> all = datasets;
+    for (double range : {64.0, 4096.0, 1.0e6}) {
+        PointGenerator::Options options;
+        options.seed = 17;
+        options.maxX = range;
+        options.maxY = range;
+        options.integral = true;
+        all.push_back({"200k in range " + std::to_string(static_cast<long long>(range)),
+                       PointGenerator::generate(options, 200000)});
+    }
+    all.push_back({"signed zeros", {Point(0.0, -0.0), Point(-0.0, 0.0), Point(0.0, 0.0), Point(0.5, -0.0)}});
+
+    for (const Dataset& dataset : all) {
+        std::vector<PointI> integerPoints;
+        if (toIntegerPoints(dataset.points, integerPoints)) {
+            checkDeduplicated(deduplicator, integerPoints, dataset.label + " (integer)");
+        }
+        checkDeduplicated(deduplicator, dataset.points, dataset.label);
+
+        std::vector<Point> unique;
+        deduplicator.run(dataset.points, unique);
+        const std::vector<Point> hull = algorithm->computeHull(unique);
+        if (dataset.points.size() <= 100) {
+            std::string error;
+            CHECK(isExactHull(dataset.points, hull, error),
+                  "hull after PointDeduplicator on " + dataset.label + ": " + error);
+        } else {
+            CHECK(pointSet(hull) == pointSet(algorithm->computeHull(dataset.points)),
+                  "hull after PointDeduplicator on " + dataset.label);
+        }
+    }
+}
+
+// Inputs large enough to be profiled, built so that every strategy is taken
+// at least once; each hull must match plain Andrew's.
+void checkAutoStrategies()
+{
+    AndrewsAlgorithm andrew;
+    AutoHull autoHull;
+    bool taken[4] = {};
+
+    auto check = [&](const std::string& label, const std::vector<Point>& points) {
+        std::vector<PointI> integerPoints;
+        if (toIntegerPoints(points, integerPoints)) {
+            const std::vector<PointI> hull = autoHull.computeHull(integerPoints);
+            const AutoHull::Strategy strategy = autoHull.lastDecision().strategy;
+            taken[static_cast<int>(strategy)] = true;
+            CHECK(pointSet(hull) == pointSet(andrew.computeHull(integerPoints)) && hull.size() >= 1,
+                  std::string("AutoHull (") + AutoHull::strategyName(strategy) + ") on " + label + " (integer)");
+        }
+        const std::vector<Point> hull = autoHull.computeHull(points);
+        taken[static_cast<int>(autoHull.lastDecision().strategy)] = true;
+        CHECK(pointSet(hull) == pointSet(andrew.computeHull(points)),
+              std::string("AutoHull (") + AutoHull::strategyName(autoHull.lastDecision().strategy) + ") on " + label);
+        CHECK(hull.empty() || std::min_element(hull.begin(), hull.end(), lexicographicBefore<double>) == hull.begin(),
+              "AutoHull hull does not start at the lowest vertex on " + label);
+
+        if (hull.size() >= 3) {
+            const std::size_t h = hull.size();
+            bool convex = true;
+            for (std::size_t i = 0; i < h; ++i) {
+                convex = convex && orientation(hull[i], hull[(i + 1) % h], hull[(i + 2) % h]) ==
+                                       Orientation::CounterClockWise;
+            }
+            CHECK(convex, "AutoHull hull not strictly convex and counter-clockwise on " + label);
+        }
+    };
+
+    for (PointGenerator::Distribution distribution : PointGenerator::distributions()) {
+        for (double range : {40.0, 1000.0, 1.0e6}) {
+            PointGenerator::Options options;
+            options.distribution = distribution;
+            options.seed = 23;
+            options.maxX = range;
+            options.maxY = range;
+            options.integral = true;
+            std::vector<Point> points = PointGenerator::generate(options, 50000);
+            const std::string label = std::string(PointGenerator::name(distribution)) + " range " +
+                                      std::to_string(static_cast<long long>(range));
+            check(label, points);
+
+            std::sort(points.begin(), points.end(), [](const Point& a, const Point& b) {
+                return lexicographicLess(a, b);
+            });
+            check(label + " sorted", points);
+            std::reverse(points.begin(), points.end());
+            check(label + " sorted descending", points);
+        }
+    }
+
+    // Few distinct points, nearly all of them on the hull.
+    std::vector<Point> ring;
+    for (int i = 0; i < 60000; ++i) {
+        const double angle = (i % 600) * 2.0 * 3.14159265358979323846 / 600;
+        ring.emplace_back(std::round(1.0e5 * std::cos(angle)), std::round(1.0e5 * std::sin(angle)));
+    }
+    std::shuffle(ring.begin(), ring.end(), std::mt19937(5));
+    check("repeated ring", ring);
+
+    CHECK(taken[static_cast<int>(AutoHull::Strategy::Sorted)], "AutoHull never sorted plainly");
+    CHECK(taken[static_cast<int>(AutoHull::Strategy::Presorted)], "AutoHull never took the presorted path");
+    CHECK(taken[static_cast<int>(AutoHull::Strategy::Filtered)], "AutoHull never filtered");
+    CHECK(taken[static_cast<int>(AutoHull::Strategy::Deduplicated)], "AutoHull never deduplicated");
+}
+
+template<typename T>
+bool sameSequence(const std::vector<BasicPoint<T>>& a, const std::vector<BasicPoint<T>>& b)
+{
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), samePoint<T>);
+}
+
+// Melkman only promises the hull of a simple polyline, so every input here
+// is one by construction. Both algorithms start at the lowest vertex, so the
+// hulls must match vertex for vertex.
+void checkPolylines()
+{
+    std::vector<Dataset> polylines;
+
+    for (double range : {50.0, 1000.0, 1.0e6}) {
+        for (bool integral : {false, true}) {
+            for (std::size_t n : {3, 10, 1000, 200000}) {
+                PointGenerator::Options options;
+                options.distribution = PointGenerator::Distribution::Contour;
+                options.seed = n;
+                options.maxX = range;
+                options.maxY = range * 0.6;
+                options.integral = integral;
+                polylines.push_back({"contour n=" + std::to_string(n) + " range=" +
+                                         std::to_string(static_cast<long long>(range)) +
+                                         (integral ? " integral" : ""),
+                                     PointGenerator::generate(options, n)});
+            }
+        }
+    }
+
+    // Closed: the last vertex repeats the first.
+    std::vector<Point> closed = polylines.back().points;
+    closed.push_back(closed.front());
+    polylines.push_back({"closed contour", closed});
+
+    // Every vertex added again at once, and the whole path walked backwards.
+    std::vector<Point> doubled;
+    for (const Point& p : polylines[2].points) {
+        doubled.push_back(p);
+        doubled.push_back(p);
+    }
+    polylines.push_back({"contour with repeated vertices", doubled});
+    std::vector<Point> backwards(closed.rbegin(), closed.rend());
+    polylines.push_back({"contour backwards", backwards});
+
+    // Each new vertex outside the hull so far: pops on every step.
+    for (bool integral : {false, true}) {
+        std::vector<Point> spiral;
+        for (int i = 0; i < 3000; ++i) {
+            const double angle = 0.3 * i;
+            const double radius = 10.0 + 3.0 * angle;
+            Point p(radius * std::cos(angle), radius * std::sin(angle));
+            if (integral) {
+                p = Point(std::round(p.x), std::round(p.y));
+            }
+            spiral.push_back(p);
+        }
+        polylines.push_back({integral ? "spiral integral" : "spiral", spiral});
+    }
+
+    // A track that is monotone in x zigzags wildly in y.
+    std::mt19937 random(11);
+    std::uniform_int_distribution<int> height(-1000, 1000);
+    std::vector<Point> track;
+    for (int i = 0; i < 20000; ++i) {
+        track.emplace_back(i, height(random));
+    }
+    polylines.push_back({"x-monotone track", track});
+    std::reverse(track.begin(), track.end());
+    polylines.push_back({"x-monotone track backwards", track});
+
+    // Collinear starts, which the first triangle has to look past.
+    polylines.push_back({"collinear start", {Point(0, 0), Point(1, 1), Point(2, 2), Point(3, 3),
+                                             Point(3, 0), Point(6, -1)}});
+    polylines.push_back({"collinear prefix backwards",
+                         {Point(3, 3), Point(2, 2), Point(2, 2), Point(0, 0), Point(0, 5), Point(-1, 6)}});
+    polylines.push_back({"all collinear", {Point(0, 0), Point(2, 1), Point(4, 2), Point(6, 3)}});
+    polylines.push_back({"all identical", repeated(Point(4, 4), 5)});
+    polylines.push_back({"two identical", repeated(Point(4, 4), 2)});
+    polylines.push_back({"two points backwards", {Point(5, 1), Point(2, 3)}});
+    polylines.push_back({"single point", {Point(7, 2)}});
+    polylines.push_back({"empty", {}});
+
+    AndrewsAlgorithm andrew;
+    MelkmanHull melkman;
+    for (const Dataset& polyline : polylines) {
+        CHECK(sameSequence(melkman.computeHull(polyline.points), andrew.computeHull(polyline.points)),
+              "Melkman differs from Andrew on " + polyline.label);
+
+        std::vector<PointI> integerPoints;
+        if (toIntegerPoints(polyline.points, integerPoints)) {
+            CHECK(sameSequence(melkman.computeHull(integerPoints), andrew.computeHull(integerPoints)),
+                  "Melkman differs from Andrew on " + polyline.label + " (integer)");
+        }
+
+        if (polyline.points.size() <= 3000) {
+            const std::vector<AnimationStep> steps = melkman.generateSteps(polyline.points);
+            CHECK(steps.back().type == AnimationStep::FINAL_HULL &&
+                      sameSequence(steps.back().currentHull, andrew.computeHull(polyline.points)),
+                  "Melkman trace ends in a different hull on " + polyline.label);
+        }
+    }
+}
+
+} // namespace
+
+int main()
+{
+    std::vector<Dataset> datasets = degenerateDatasets();
+    const std::vector<Dataset> randomized = randomizedDatasets();
+    datasets.insert(datasets.end(), randomized.begin(), randomized.end());
+
+    checkAlgorithms(datasets);
+    checkBatch<double>(datasets);
+    checkBatch<std::int32_t>(datasets);
+    checkKinetic(datasets);
+    checkApproximate(datasets);
+    checkConvexLayers(datasets);
+    checkSummaries(datasets);
+    checkDeduplication(datasets);
+    checkAutoStrategies();
+    checkPolylines();
+
+    return testResult();
+}
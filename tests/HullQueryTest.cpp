@@ -0,0 +1,157 @@
+#include "TestSupport.h"
+
+#include "algorithms/AndrewsAlgorithm.h"
+#include "core/PointGenerator.h"
+#include "geometry/HullQuery.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool insideByBruteForce(const std::vector<Point>& hull, const Point& q)
+{
+    const std::size_t h = hull.size();
+    for (std::size_t i = 0; i < h; ++i) {
+        if (cross(hull[i], hull[(i + 1) % h], q) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Every hull vertex lies on one side of the line from q through `vertex`.
+bool isTangent(const std::vector<Point>& hull, const Point& q, const Point& vertex)
+{
+    int left = 0;
+    int right = 0;
+    for (const Point& v : hull) {
+        const double value = cross(q, vertex, v);
+        left += value > 1e-9;
+        right += value < -1e-9;
+    }
+    return left == 0 || right == 0;
+}
+
+void checkPointQueries(const HullQuery& query, const std::string& context, std::uint64_t seed)
+{
+    const std::vector<Point>& hull = query.vertices();
+    std::mt19937_64 random(seed);
+    std::uniform_real_distribution<double> xs(-300.0, 1300.0);
+    std::uniform_real_distribution<double> ys(-300.0, 1100.0);
+    std::uniform_real_distribution<double> angles(0.0, 2.0 * M_PI);
+
+    for (int i = 0; i < 500; ++i) {
+        // Every few queries land exactly on a vertex.
+        const Point q = (i % 7 == 0) ? hull[random() % hull.size()] : Point(xs(random), ys(random));
+
+        const bool inside = insideByBruteForce(hull, q);
+        CHECK(query.contains(q) == inside, context + ": contains disagrees");
+
+        if (!inside) {
+            HullQuery::Tangents tangents;
+            CHECK(query.tangents(q, tangents), context + ": no tangents from an outside point");
+            if (tangents.first >= 0 && tangents.second >= 0) {
+                CHECK(isTangent(hull, q, hull[tangents.first]), context + ": bad first tangent");
+                CHECK(isTangent(hull, q, hull[tangents.second]), context + ": bad second tangent");
+            }
+        }
+
+        const double angle = angles(random);
+        const double dx = std::cos(angle);
+        const double dy = std::sin(angle);
+        double best = -1e300;
+        for (const Point& v : hull) {
+            best = std::max(best, v.x * dx + v.y * dy);
+        }
+        const Point& extreme = hull[query.extremeVertex(dx, dy)];
+        CHECK(extreme.x * dx + extreme.y * dy >= best - 1e-6,
+              context + ": extremeVertex is not extreme");
+    }
+}
+
+void checkCalipers(const HullQuery& query, const std::string& context)
+{
+    const std::vector<Point>& hull = query.vertices();
+    const std::size_t h = hull.size();
+
+    double diameter = 0.0;
+    for (const Point& a : hull) {
+        for (const Point& b : hull) {
+            diameter = std::max(diameter, std::hypot(a.x - b.x, a.y - b.y));
+        }
+    }
+
+    // Both the minimum width and the minimum-area rectangle have a side
+    // flush with some hull edge.
+    double width = 1e300;
+    double area = 1e300;
+    for (std::size_t i = 0; i < h; ++i) {
+        const Point& p0 = hull[i];
+        const Point& p1 = hull[(i + 1) % h];
+        const double length = std::hypot(p1.x - p0.x, p1.y - p0.y);
+        const double ux = (p1.x - p0.x) / length;
+        const double uy = (p1.y - p0.y) / length;
+
+        double height = 0.0;
+        double low = 1e300;
+        double high = -1e300;
+        for (const Point& v : hull) {
+            height = std::max(height, std::abs(cross(p0, p1, v)) / length);
+            low = std::min(low, v.x * ux + v.y * uy);
+            high = std::max(high, v.x * ux + v.y * uy);
+        }
+        width = std::min(width, height);
+        area = std::min(area, (high - low) * height);
+    }
+
+    CHECK(std::abs(diameter - query.diameter().length) <= 1e-6, context + ": wrong diameter");
+    CHECK(std::abs(width - query.width().length) <= 1e-6, context + ": wrong width");
+    CHECK(std::abs(area - query.minAreaRectangle().area) <= 1e-6 * area,
+          context + ": wrong minimum-area rectangle");
+}
+
+} // namespace
+
+int main()
+{
+    AndrewsAlgorithm andrew;
+
+    for (PointGenerator::Distribution distribution : PointGenerator::distributions()) {
+        for (std::uint64_t seed = 0; seed < 20; ++seed) {
+            PointGenerator::Options options;
+            options.distribution = distribution;
+            options.seed = seed;
+            options.maxX = 1000.0;
+            options.maxY = 800.0;
+            options.integral = seed % 2 == 0;
+
+            const std::vector<Point> points = PointGenerator::generate(options, 5 + seed * 37);
+            const HullQuery query(andrew.computeHull(points));
+            if (!query.isValid()) {
+                continue;
+            }
+
+            const std::string context = std::string(PointGenerator::name(distribution)) +
+                                        " seed=" + std::to_string(seed);
+            checkPointQueries(query, context, seed);
+            checkCalipers(query, context);
+        }
+    }
+
+    const HullQuery segment({Point(0, 0), Point(10, 10)});
+    CHECK(!segment.isValid(), "a segment is not a valid query polygon");
+
+    const HullQuery square({Point(10, 0), Point(10, 10), Point(0, 10), Point(0, 0), Point(5, 0)});
+    CHECK(square.isValid() && square.vertices().size() == 4,
+          "collinear vertices are dropped when building");
+    CHECK(square.contains(Point(5, 0)) && square.contains(Point(5, 5)) &&
+              !square.contains(Point(11, 5)),
+          "square containment");
+
+    return testResult();
+}
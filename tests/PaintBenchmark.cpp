@@ -0,0 +1,274 @@
+#include "core/AppState.h"
+#include "core/PointGenerator.h"
+#include "gui/DrawWidget.h"
+
+#include <QApplication>
+#include <QImage>
+#include <QMouseEvent>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Frame times of DrawWidget::paintEvent without a display. The widget paints
+// into an offscreen QImage under the offscreen platform plugin while an
+// AppState replays a recorded Andrew trace. Each frame kind is timed
+// separately:
+//
+//   sort      the first step, every point highlighted
+//   remove    REMOVE_FROM_HULL steps, spread over the whole trace
+//   final     the finished hull
+//   hover     the finished hull with the mouse moving over it, which only
+//             redraws the hull query overlay over the cached scene
+//
+// The first three drop the widget's cached scene before every frame, so
+// they are full paints.
+//
+// and reported as per-frame percentiles for every point count and render
+// mode. With --budget the run fails if a p90 exceeds it.
+//
+//   PaintBenchmark [--points N[,N...]] [--frames N] [--size WxH]
+//                  [--render points|density|auto[,...]] [--budget MS]
+//
+// Traces store a hull snapshot per step, so counts far above 100k need a lot
+// of memory.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct RenderMode
+{
+    const char* name;
+    DrawWidget::RenderMode mode;
+};
+
+const RenderMode RenderModes[] = {
+    {"auto", DrawWidget::RenderMode::Auto},
+    {"points", DrawWidget::RenderMode::Points},
+    {"density", DrawWidget::RenderMode::Density}
+};
+
+struct Options
+{
+    std::vector<std::size_t> counts = {1000, 10000, 100000};
+    int frames = 100;
+    int width = 1280;
+    int height = 800;
+    std::vector<RenderMode> modes = {RenderModes[1], RenderModes[2]};
+    double budgetMs = 0.0;
+};
+
+// Comma-separated list; false on an empty or unknown entry.
+template<typename Fn>
+bool parseList(const char* text, Fn&& parseItem)
+{
+    const std::string list(text);
+    std::size_t begin = 0;
+    while (begin <= list.size()) {
+        const std::size_t end = std::min(list.find(',', begin), list.size());
+        if (end == begin || !parseItem(list.substr(begin, end - begin))) {
+            return false;
+        }
+        begin = end + 1;
+    }
+    return true;
+}
+
+bool parseArguments(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        bool valid = true;
+        if (std::strcmp(argv[i], "--points") == 0 && i + 1 < argc) {
+            options.counts.clear();
+            valid = parseList(argv[++i], [&](const std::string& item) {
+                const long long count = std::atoll(item.c_str());
+                options.counts.push_back(static_cast<std::size_t>(count));
+                return count >= 3;
+            });
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            options.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            valid = std::sscanf(argv[++i], "%dx%d", &options.width, &options.height) == 2 &&
+                    options.width > 0 && options.height > 0;
+        } else if (std::strcmp(argv[i], "--render") == 0 && i + 1 < argc) {
+            options.modes.clear();
+            valid = parseList(argv[++i], [&](const std::string& item) {
+                for (const RenderMode& mode : RenderModes) {
+                    if (item == mode.name) {
+                        options.modes.push_back(mode);
+                        return true;
+                    }
+                }
+                return false;
+            });
+        } else if (std::strcmp(argv[i], "--budget") == 0 && i + 1 < argc) {
+            options.budgetMs = std::atof(argv[++i]);
+        } else {
+            valid = false;
+        }
+
+        if (!valid) {
+            std::fprintf(stderr,
+                         "usage: %s [--points N[,N...]] [--frames N] [--size WxH]\n"
+                         "       [--render points|density|auto[,...]] [--budget MS]\n",
+                         argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+double percentile(const std::vector<double>& sorted, double fraction)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const std::size_t index = static_cast<std::size_t>(std::ceil(fraction * sorted.size()));
+    return sorted[std::min(sorted.size(), std::max<std::size_t>(index, 1)) - 1];
+}
+
+// At most `limit` entries of `indices`, evenly spread.
+std::vector<int> spread(const std::vector<int>& indices, std::size_t limit)
+{
+    if (indices.size() <= limit) {
+        return indices;
+    }
+    std::vector<int> picked(limit);
+    for (std::size_t i = 0; i < limit; ++i) {
+        picked[i] = indices[i * indices.size() / limit];
+    }
+    return picked;
+}
+
+struct FrameKind
+{
+    const char* name;
+    std::vector<int> steps;
+    bool hover;
+};
+
+// Sweeps the mouse along the widget's horizontal center line.
+void hoverAt(DrawWidget& widget, int frame)
+{
+    const QPointF position((frame * 37) % std::max(1, widget.width()), widget.height() / 2.0);
+    QMouseEvent move(QEvent::MouseMove, position, widget.mapToGlobal(position), Qt::NoButton, Qt::NoButton,
+                     Qt::NoModifier);
+    QApplication::sendEvent(&widget, &move);
+}
+
+// Replays the kind's steps round-robin for `frames` frames plus one warm-up
+// frame, which also builds the widget's point index. Only render() is timed.
+std::vector<double> timeFrames(AppState& state, DrawWidget& widget, QImage& image, const FrameKind& kind,
+                               int frames)
+{
+    std::vector<double> samples;
+    samples.reserve(frames);
+
+    state.seek(kind.steps.front());
+    widget.render(&image);
+
+    for (int frame = 0; frame < frames; ++frame) {
+        state.seek(kind.steps[frame % kind.steps.size()]);
+        if (kind.hover) {
+            hoverAt(widget, frame);
+        } else {
+            widget.invalidateScene();
+        }
+        const Clock::time_point start = Clock::now();
+        widget.render(&image);
+        const Clock::time_point end = Clock::now();
+        samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    if (kind.hover) {
+        QEvent leave(QEvent::Leave);
+        QApplication::sendEvent(&widget, &leave);
+    }
+
+    std::sort(samples.begin(), samples.end());
+    return samples;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    // No display needed; an explicit platform from the environment wins.
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication application(argc, argv);
+
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        return 2;
+    }
+
+    const QSize size(options.width, options.height);
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    int overBudget = 0;
+
+    std::printf("%-9s %-8s %-7s %7s %9s %9s %9s %9s\n",
+                "points", "render", "frame", "frames", "p50 ms", "p90 ms", "p99 ms", "max ms");
+
+    for (std::size_t count : options.counts) {
+        AppState state;
+        DrawWidget widget(&state);
+        widget.resize(size);
+
+        // Pixel points, as the window's "Add points" generates them.
+        PointGenerator::Options generator;
+        generator.seed = 20240601;
+        generator.maxX = options.width;
+        generator.maxY = options.height;
+        generator.integral = true;
+        state.generatePoints(generator, count);
+
+        state.stepForward();
+        const int total = state.totalSteps();
+        std::vector<int> removeSteps;
+        for (int i = 1; i <= total; ++i) {
+            state.seek(i);
+            if (state.currentStep()->type == AnimationStep::REMOVE_FROM_HULL) {
+                removeSteps.push_back(i);
+            }
+        }
+
+        std::vector<FrameKind> kinds = {
+            {"sort", {1}, false},
+            {"remove", spread(removeSteps, static_cast<std::size_t>(options.frames)), false},
+            {"final", {total}, false},
+            {"hover", {total}, true}
+        };
+
+        for (const RenderMode& mode : options.modes) {
+            widget.setRenderMode(mode.mode);
+            for (const FrameKind& kind : kinds) {
+                if (kind.steps.empty()) {
+                    continue;
+                }
+                const std::vector<double> samples = timeFrames(state, widget, image, kind, options.frames);
+                const double p90 = percentile(samples, 0.90);
+                const bool over = options.budgetMs > 0.0 && p90 > options.budgetMs;
+                overBudget += over;
+                std::printf("%-9zu %-8s %-7s %7zu %9.3f %9.3f %9.3f %9.3f%s\n",
+                            count, mode.name, kind.name, samples.size(),
+                            percentile(samples, 0.50), p90, percentile(samples, 0.99), samples.back(),
+                            over ? "  OVER BUDGET" : "");
+                std::fflush(stdout);
+            }
+        }
+    }
+
+    if (overBudget > 0) {
+        std::printf("%d frame kind(s) with a p90 above %.3f ms\n", overBudget, options.budgetMs);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include "TestSupport.h"
+
+#include "core/PointIO.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<Point> parse(const std::string& text, unsigned threads = 1, PointIO::ParseStats* p_stats = nullptr)
+{
+    std::vector<Point> points;
+    const PointIO::ParseStats stats = PointIO::parse(text.data(), text.data() + text.size(), points, threads);
+    if (p_stats) {
+        *p_stats = stats;
+    }
+    return points;
+}
+
+bool sameBits(double a, double b)
+{
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// Separators, comments, headers, signs, exponents and line endings.
+void checkFormats()
+{
+    PointIO::ParseStats stats;
+    const std::vector<Point> points = parse(
+        "x,y\n"
+        "# comment\n"
+        "\n"
+        "1 2\n"
+        "  -3.5\t+4.25\r\n"
+        "5,6\n"
+        "7 ; 8, extra columns\n"
+        "1e3 -2.5E-1\n"
+        ".5 5.\n"
+        "9\n"
+        "10 11", 1, &stats);
+
+    const std::vector<Point> expected = {
+        Point(1, 2), Point(-3.5, 4.25), Point(5, 6), Point(7, 8), Point(1000, -0.25), Point(0.5, 5), Point(10, 11)
+    };
+    CHECK(points.size() == expected.size(), "parsed " + std::to_string(points.size()) + " points");
+    for (std::size_t i = 0; i < std::min(points.size(), expected.size()); ++i) {
+        CHECK(samePoint(points[i], expected[i]), "point " + std::to_string(i));
+    }
+    CHECK(stats.lines == 9, "counted " + std::to_string(stats.lines) + " lines");
+    CHECK(stats.invalidLines == 2, "counted " + std::to_string(stats.invalidLines) + " invalid lines");
+}
+
+// Formatted values must parse back to the same bits, including values that
+// need the slow path: long mantissas, tiny and huge exponents, subnormals.
+void checkRoundTrip()
+{
+    std::mt19937_64 random(11);
+    std::vector<Point> points;
+    for (int i = 0; i < 20000; ++i) {
+        std::uint64_t bits = random();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        if (value != value || value == std::numeric_limits<double>::infinity() ||
+            value == -std::numeric_limits<double>::infinity())
+        {
+            value = 0.0;
+        }
+        points.emplace_back(value, static_cast<double>(static_cast<std::int64_t>(random() % 4000001) - 2000000) / 64.0);
+    }
+    points.emplace_back(std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::max());
+    points.emplace_back(9007199254740993.0, 0.1);
+
+    for (char separator : {' ', ','}) {
+        std::string text;
+        PointIO::format(points, separator, text);
+        const std::vector<Point> parsed = parse(text);
+
+        CHECK(parsed.size() == points.size(), "round trip lost points");
+        for (std::size_t i = 0; i < std::min(points.size(), parsed.size()); ++i) {
+            CHECK(sameBits(parsed[i].x, points[i].x) && sameBits(parsed[i].y, points[i].y),
+                  "round trip of point " + std::to_string(i));
+        }
+    }
+}
+
+// The chunked parse splits at line boundaries and keeps the input order.
+void checkThreads()
+{
+    std::string text;
+    for (int i = 0; i < 300000; ++i) {
+        text += std::to_string(i) + " " + std::to_string(-i) + (i % 7 == 0 ? "\r\n" : "\n");
+    }
+
+    PointIO::ParseStats stats;
+    const std::vector<Point> parsed = parse(text, 4, &stats);
+    bool ordered = parsed.size() == 300000;
+    for (std::size_t i = 0; ordered && i < parsed.size(); ++i) {
+        ordered = parsed[i].x == static_cast<double>(i) && parsed[i].y == -static_cast<double>(i);
+    }
+    CHECK(ordered, "chunked parse changed or lost points");
+    CHECK(stats.lines == 300000 && stats.invalidLines == 0, "chunked parse miscounted lines");
+}
+
+} // namespace
+
+int main()
+{
+    checkFormats();
+    checkRoundTrip();
+    checkThreads();
+
+    return testResult();
+}
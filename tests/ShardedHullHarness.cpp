@@ -0,0 +1,277 @@
+#include "algorithms/AlgorithmRegistry.h"
+#include "algorithms/HullSummary.h"
+#include "core/PointGenerator.h"
+#include "geometry/PointConversion.h"
+
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QProcess>
+#include <QStringList>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+// End-to-end comparison of two ways to get the hull of data spread over
+// several worker processes:
+//
+//   raw       every worker sends its points, the reducer computes one hull
+//   summary   every worker sends the HullSummary of its points, the reducer
+//             merges the summaries pairwise
+//
+// Workers are this executable started again with --worker. Each generates
+// its own shard from a seed, so both runs see the same data. Fails if the
+// two hulls differ.
+//
+//   ShardedHullHarness [--shards N] [--points N-PER-SHARD] [--distribution NAME]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options
+{
+    int shards = 4;
+    int points = 1000000;
+    PointGenerator::Distribution distribution = PointGenerator::Distribution::Uniform;
+    // Set in worker processes only.
+    int worker = -1;
+    bool summary = false;
+};
+
+bool parseArguments(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--shards") == 0 && i + 1 < argc) {
+            options.shards = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--points") == 0 && i + 1 < argc) {
+            options.points = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--distribution") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            bool found = false;
+            for (PointGenerator::Distribution distribution : PointGenerator::distributions()) {
+                if (std::strcmp(PointGenerator::name(distribution), name) == 0) {
+                    options.distribution = distribution;
+                    found = true;
+                }
+            }
+            if (!found) {
+                std::fprintf(stderr, "unknown distribution %s\n", name);
+                return false;
+            }
+        } else if (std::strcmp(argv[i], "--worker") == 0 && i + 1 < argc) {
+            options.worker = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--summary") == 0) {
+            options.summary = true;
+        } else {
+            std::fprintf(stderr, "usage: %s [--shards N] [--points N] [--distribution NAME]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<Point> computeHull(const std::vector<Point>& points)
+{
+    const std::unique_ptr<ConvexHullAlgorithm> algorithm = AlgorithmRegistry::algorithms().front().create();
+
+    std::vector<Point> hull;
+    std::vector<PointI> integerPoints;
+    if (toIntegerPoints(points, integerPoints)) {
+        std::vector<PointI> integerHull;
+        algorithm->computeHullInto(integerPoints, integerHull);
+        toPoints(integerHull, hull);
+    } else {
+        algorithm->computeHullInto(points, hull);
+    }
+    return hull;
+}
+
+// Writes either the raw shard or its summary to stdout.
+int runWorker(const Options& options)
+{
+#ifdef _WIN32
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+    PointGenerator::Options generatorOptions;
+    generatorOptions.distribution = options.distribution;
+    generatorOptions.seed = static_cast<std::uint64_t>(options.worker);
+    generatorOptions.maxX = 1 << 20;
+    generatorOptions.maxY = 1 << 20;
+    generatorOptions.integral = true;
+    const std::vector<Point> points = PointGenerator::generate(generatorOptions, options.points);
+
+    if (options.summary) {
+        std::string out;
+        HullSummary::fromHull(computeHull(points), points.size()).serialize(out);
+        std::fwrite(out.data(), 1, out.size(), stdout);
+    } else {
+        std::fwrite(points.data(), sizeof(Point), points.size(), stdout);
+    }
+    return std::fflush(stdout) == 0 ? 0 : 1;
+}
+
+// Starts all workers at once and collects their output as it arrives.
+bool runShards(const Options& options, bool summary, std::vector<QByteArray>& outputs)
+{
+    std::vector<std::unique_ptr<QProcess>> processes;
+    outputs.assign(options.shards, QByteArray());
+    QEventLoop loop;
+    int running = options.shards;
+    bool ok = true;
+
+    for (int shard = 0; shard < options.shards; ++shard) {
+        processes.push_back(std::make_unique<QProcess>());
+        QProcess* p_process = processes.back().get();
+
+        QStringList arguments = {"--worker", QString::number(shard),
+                                 "--points", QString::number(options.points),
+                                 "--distribution", PointGenerator::name(options.distribution)};
+        if (summary) {
+            arguments << "--summary";
+        }
+
+        QObject::connect(p_process, &QProcess::readyReadStandardOutput, [p_process, &outputs, shard]() {
+            outputs[shard] += p_process->readAllStandardOutput();
+        });
+        QObject::connect(p_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+                         [p_process, &outputs, &loop, &running, &ok, shard](int exitCode, QProcess::ExitStatus status) {
+            outputs[shard] += p_process->readAllStandardOutput();
+            ok = ok && status == QProcess::NormalExit && exitCode == 0;
+            if (--running == 0) {
+                loop.quit();
+            }
+        });
+        QObject::connect(p_process, &QProcess::errorOccurred, [&loop, &running, &ok](QProcess::ProcessError error) {
+            if (error == QProcess::FailedToStart) {
+                ok = false;
+                if (--running == 0) {
+                    loop.quit();
+                }
+            }
+        });
+
+        p_process->start(QCoreApplication::applicationFilePath(), arguments);
+    }
+
+    if (running > 0) {
+        loop.exec();
+    }
+    return ok;
+}
+
+std::vector<Point> reduceRaw(const std::vector<QByteArray>& outputs)
+{
+    std::vector<Point> points;
+    for (const QByteArray& output : outputs) {
+        const std::size_t first = points.size();
+        points.resize(first + output.size() / sizeof(Point));
+        std::memcpy(points.data() + first, output.constData(), (points.size() - first) * sizeof(Point));
+    }
+    return computeHull(points);
+}
+
+bool reduceSummaries(const std::vector<QByteArray>& outputs, HullSummary& result)
+{
+    std::vector<HullSummary> summaries(outputs.size());
+    for (std::size_t i = 0; i < outputs.size(); ++i) {
+        if (HullSummary::deserialize(outputs[i].constData(), outputs[i].size(), summaries[i]) == 0) {
+            return false;
+        }
+    }
+
+    // Pairwise, as a reducer tree would.
+    while (summaries.size() > 1) {
+        std::vector<HullSummary> next;
+        for (std::size_t i = 0; i + 1 < summaries.size(); i += 2) {
+            next.push_back(HullSummary::merge(summaries[i], summaries[i + 1]));
+        }
+        if (summaries.size() % 2 == 1) {
+            next.push_back(summaries.back());
+        }
+        summaries.swap(next);
+    }
+    result = summaries.front();
+    return true;
+}
+
+double millisecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    QCoreApplication application(argc, argv);
+
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        return 2;
+    }
+
+    if (options.worker >= 0) {
+        return runWorker(options);
+    }
+
+    std::vector<QByteArray> outputs;
+
+    const Clock::time_point rawStart = Clock::now();
+    if (!runShards(options, false, outputs)) {
+        std::fprintf(stderr, "a raw worker failed\n");
+        return 1;
+    }
+    std::size_t rawBytes = 0;
+    for (const QByteArray& output : outputs) {
+        rawBytes += output.size();
+    }
+    const std::vector<Point> rawHull = HullSummary::fromHull(reduceRaw(outputs), 0).hull();
+    const double rawMs = millisecondsSince(rawStart);
+
+    const Clock::time_point summaryStart = Clock::now();
+    if (!runShards(options, true, outputs)) {
+        std::fprintf(stderr, "a summary worker failed\n");
+        return 1;
+    }
+    std::size_t summaryBytes = 0;
+    for (const QByteArray& output : outputs) {
+        summaryBytes += output.size();
+    }
+    HullSummary merged;
+    if (!reduceSummaries(outputs, merged)) {
+        std::fprintf(stderr, "a worker sent an invalid summary\n");
+        return 1;
+    }
+    const double summaryMs = millisecondsSince(summaryStart);
+
+    std::printf("%d shard(s) of %d %s points\n",
+                options.shards, options.points, PointGenerator::name(options.distribution));
+    std::printf("raw points   %10.1f ms  %12zu bytes to the reducer\n", rawMs, rawBytes);
+    std::printf("summaries    %10.1f ms  %12zu bytes to the reducer\n", summaryMs, summaryBytes);
+    std::printf("speedup      %10.2fx\n", rawMs / summaryMs);
+
+    const bool same = merged.hull().size() == rawHull.size() &&
+                      std::equal(rawHull.begin(), rawHull.end(), merged.hull().begin(), [](const Point& a, const Point& b) {
+                          return a.x == b.x && a.y == b.y;
+                      });
+    const bool counted = merged.pointCount() == static_cast<std::uint64_t>(options.shards) * options.points;
+    if (!same || !counted) {
+        std::printf("Merged summary does not match the hull of all points\n");
+        return 1;
+    }
+
+    std::printf("Hulls match (%zu vertices)\n", rawHull.size());
+    return 0;
+}
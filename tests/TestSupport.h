@@ -0,0 +1,147 @@
+#ifndef TESTSUPPORT_H
+#define TESTSUPPORT_H
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "geometry/Orientation.h"
+#include "geometry/Point.h"
+
+// Minimal assertion helpers shared by the test executables. A failed CHECK
+// is reported and counted; the executable returns testResult() so that CTest
+// sees a non-zero exit code.
+inline int& testFailureCount()
+{
+    static int count = 0;
+    return count;
+}
+
+inline int testResult()
+{
+    if (testFailureCount() == 0) {
+        std::printf("All checks passed\n");
+        return 0;
+    }
+
+    std::printf("%d check(s) failed\n", testFailureCount());
+    return 1;
+}
+
+#define CHECK(condition, message)                                              \
+    do {                                                                       \
+        if (!(condition)) {                                                    \
+            ++testFailureCount();                                              \
+            std::printf("%s:%d: CHECK(%s) failed: %s\n",                       \
+                        __FILE__, __LINE__, #condition,                        \
+                        std::string(message).c_str());                         \
+        }                                                                      \
+    } while (false)
+
+template<typename T>
+bool samePoint(const BasicPoint<T>& a, const BasicPoint<T>& b)
+{
+    return a.x == b.x && a.y == b.y;
+}
+
+template<typename T>
+bool lexicographicBefore(const BasicPoint<T>& a, const BasicPoint<T>& b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+template<typename T>
+std::vector<BasicPoint<T>> sortedUnique(std::vector<BasicPoint<T>> points)
+{
+    std::sort(points.begin(), points.end(), lexicographicBefore<T>);
+    points.erase(std::unique(points.begin(), points.end(), samePoint<T>), points.end());
+    return points;
+}
+
+// True if r lies on the closed segment pq. Assumes r is collinear with pq.
+template<typename T>
+bool onSegment(const BasicPoint<T>& p, const BasicPoint<T>& q, const BasicPoint<T>& r)
+{
+    return std::min(p.x, q.x) <= r.x && r.x <= std::max(p.x, q.x) &&
+           std::min(p.y, q.y) <= r.y && r.y <= std::max(p.y, q.y);
+}
+
+// O(n^3) reference: p -> q is a counter-clockwise hull edge if every other
+// point is strictly to its left or on the segment itself. Returns the strict
+// hull vertices (no collinear points) in lexicographic order. Exact for
+// integer coordinates and for doubles holding small integers.
+template<typename T>
+std::vector<BasicPoint<T>> bruteForceHull(const std::vector<BasicPoint<T>>& input)
+{
+    const std::vector<BasicPoint<T>> points = sortedUnique(input);
+    if (points.size() < 2) {
+        return points;
+    }
+
+    std::vector<BasicPoint<T>> vertices;
+    for (const BasicPoint<T>& p : points) {
+        for (const BasicPoint<T>& q : points) {
+            if (samePoint(p, q)) {
+                continue;
+            }
+
+            bool isEdge = true;
+            for (const BasicPoint<T>& r : points) {
+                const auto value = cross(p, q, r);
+                if (value < 0 || (value == 0 && !onSegment(p, q, r))) {
+                    isEdge = false;
+                    break;
+                }
+            }
+
+            if (isEdge) {
+                vertices.push_back(p);
+                vertices.push_back(q);
+            }
+        }
+    }
+
+    return sortedUnique(vertices);
+}
+
+// Checks that `hull` has exactly the vertices of the brute-force hull of
+// `points`, without repeats, and that it is strictly convex and
+// counter-clockwise. On failure `error` describes the first problem found.
+template<typename T>
+bool isExactHull(const std::vector<BasicPoint<T>>& points,
+                 const std::vector<BasicPoint<T>>& hull,
+                 std::string& error)
+{
+    const std::vector<BasicPoint<T>> expected = bruteForceHull(points);
+    const std::vector<BasicPoint<T>> actual = sortedUnique(hull);
+
+    if (actual.size() != hull.size()) {
+        error = "hull repeats a vertex";
+        return false;
+    }
+
+    if (actual.size() != expected.size() ||
+        !std::equal(actual.begin(), actual.end(), expected.begin(), samePoint<T>))
+    {
+        error = "expected " + std::to_string(expected.size()) + " vertices, got " +
+                std::to_string(hull.size()) + " (or different ones)";
+        return false;
+    }
+
+    const std::size_t h = hull.size();
+    if (h >= 3) {
+        for (std::size_t i = 0; i < h; ++i) {
+            if (orientation(hull[i], hull[(i + 1) % h], hull[(i + 2) % h]) !=
+                Orientation::CounterClockWise)
+            {
+                error = "hull is not strictly convex and counter-clockwise";
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+#endif // TESTSUPPORT_H
@@ -0,0 +1,186 @@
+#include "TestSupport.h"
+
+#include "core/Parallel.h"
+#include "core/ThreadPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Pools larger than the machine are fine here: correctness must not depend
+// on how many threads actually run at once.
+
+namespace {
+
+void checkParallelFor()
+{
+    for (unsigned threads : {1u, 2u, 5u}) {
+        ThreadPool::Options options;
+        options.threads = threads;
+        ThreadPool pool(options);
+        CHECK(pool.concurrency() == threads, "wrong concurrency for " + std::to_string(threads) + " threads");
+
+        for (std::size_t grain : {1, 7, 1000, 100000}) {
+            const std::string label = std::to_string(threads) + " threads, grain " + std::to_string(grain);
+
+            std::vector<std::atomic<int>> visits(20011);
+            std::atomic<bool> aligned{true};
+            pool.parallelFor(3, visits.size(), grain, [&](std::size_t begin, std::size_t end) {
+                if ((begin - 3) % grain != 0 || (end != visits.size() && (end - begin) % grain != 0)) {
+                    aligned = false;
+                }
+                for (std::size_t i = begin; i < end; ++i) {
+                    ++visits[i];
+                }
+            });
+
+            bool once = true;
+            for (std::size_t i = 0; i < visits.size(); ++i) {
+                once = once && visits[i].load() == (i < 3 ? 0 : 1);
+            }
+            CHECK(once, "parallelFor missed or repeated an index with " + label);
+            CHECK(aligned.load(), "parallelFor chunk not aligned to the grain with " + label);
+        }
+
+        int calls = 0;
+        pool.parallelFor(5, 5, 1, [&](std::size_t, std::size_t) { ++calls; });
+        CHECK(calls == 0, "parallelFor called fn for an empty range");
+    }
+}
+
+// Floating-point sums only match across thread counts if the chunks are
+// combined in the same order.
+void checkParallelReduce()
+{
+    std::vector<double> values(100003);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = 1.0 / (1.0 + static_cast<double>(i % 977)) * (i % 2 == 0 ? 1e8 : 1e-8);
+    }
+
+    auto sum = [&](ThreadPool& pool) {
+        return pool.parallelReduce(0, values.size(), 1000, 0.0,
+                                   [&](std::size_t begin, std::size_t end) {
+                                       double s = 0.0;
+                                       for (std::size_t i = begin; i < end; ++i) {
+                                           s += values[i];
+                                       }
+                                       return s;
+                                   },
+                                   [](double a, double b) { return a + b; });
+    };
+
+    ThreadPool::Options options;
+    options.threads = 1;
+    ThreadPool single(options);
+    options.threads = 4;
+    ThreadPool four(options);
+    const double expected = sum(single);
+    CHECK(sum(four) == expected, "parallelReduce depends on the thread count");
+
+    const std::uint64_t count = four.parallelReduce(
+        0, 12345, 100, std::uint64_t(0),
+        [](std::size_t begin, std::size_t end) { return std::uint64_t(end - begin); },
+        [](std::uint64_t a, std::uint64_t b) { return a + b; });
+    CHECK(count == 12345, "parallelReduce lost elements");
+    CHECK(four.parallelReduce(7, 7, 1, 42, [](std::size_t, std::size_t) { return 0; },
+                              [](int a, int b) { return a + b; }) == 42,
+          "parallelReduce of an empty range is not the identity");
+}
+
+// Tasks that wait for tasks of their own, deeper than there are threads.
+void checkNesting()
+{
+    ThreadPool::Options options;
+    options.threads = 3;
+    ThreadPool pool(options);
+
+    std::atomic<int> leaves{0};
+    pool.parallelFor(0, 8, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            ThreadPool::TaskGroup group(pool);
+            for (int j = 0; j < 8; ++j) {
+                group.run([&]() {
+                    pool.parallelFor(0, 16, 1, [&](std::size_t first, std::size_t last) {
+                        leaves += static_cast<int>(last - first);
+                    });
+                });
+            }
+            group.wait();
+        }
+    });
+    CHECK(leaves.load() == 8 * 8 * 16, "nested parallel work lost tasks");
+
+    std::uint64_t tasks = 0;
+    for (const ThreadPool::WorkerStats& worker : pool.stats()) {
+        tasks += worker.tasks;
+        CHECK(worker.utilization >= 0.0 && worker.utilization <= 1.0, "utilization out of range");
+    }
+    CHECK(pool.stats().size() == 2, "expected stats for two workers");
+    pool.resetStats();
+    for (const ThreadPool::WorkerStats& worker : pool.stats()) {
+        CHECK(worker.tasks == 0 && worker.steals == 0, "resetStats left counts behind");
+    }
+}
+
+// A wait must not pick up another caller's task: with both workers and two
+// other threads busy on long loops, a short loop has to stay short.
+void checkWaitIsolation()
+{
+    using Clock = std::chrono::steady_clock;
+    const std::chrono::milliseconds longTask(100);
+
+    ThreadPool::Options options;
+    options.threads = 3;
+    ThreadPool pool(options);
+
+    auto longLoop = [&]() {
+        pool.parallelFor(0, 8, 1, [&](std::size_t, std::size_t) { std::this_thread::sleep_for(longTask); });
+    };
+    std::thread first(longLoop);
+    std::thread second(longLoop);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    std::atomic<int> visits{0};
+    const Clock::time_point start = Clock::now();
+    pool.parallelFor(0, 64, 1, [&](std::size_t begin, std::size_t end) { visits += static_cast<int>(end - begin); });
+    const Clock::duration elapsed = Clock::now() - start;
+
+    first.join();
+    second.join();
+    CHECK(visits.load() == 64, "short parallelFor lost elements");
+    CHECK(elapsed < longTask / 2, "a short parallelFor waited for another caller's task");
+}
+
+void checkGlobal()
+{
+    ThreadPool::Options options;
+    options.threads = 3;
+    options.affinity = ThreadPool::Affinity::Compact;
+    ThreadPool pool(options);
+
+    ThreadPool::install(&pool);
+    CHECK(&ThreadPool::global() == &pool && parallelWorkerCount() == 3, "installed pool is not the global one");
+
+    std::atomic<std::size_t> total{0};
+    parallelFor(0, 1000, 10, [&](std::size_t begin, std::size_t end) { total += end - begin; });
+    CHECK(total.load() == 1000, "parallelFor on the installed pool lost elements");
+
+    ThreadPool::install(nullptr);
+    CHECK(&ThreadPool::global() != &pool, "uninstalled pool is still the global one");
+}
+
+} // namespace
+
+int main()
+{
+    checkParallelFor();
+    checkParallelReduce();
+    checkNesting();
+    checkWaitIsolation();
+    checkGlobal();
+
+    return testResult();
+}
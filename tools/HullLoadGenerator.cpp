@@ -0,0 +1,237 @@
+#include "service/HullProtocol.h"
+#include "core/PointGenerator.h"
+
+#include <QCoreApplication>
+#include <QLocalSocket>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Load generator for the hull service (ConvexHullVisualizer --serve NAME).
+// Every connection runs on its own thread and keeps a fixed number of
+// requests in flight; the report gives the overall request rate and the
+// latency distribution measured from sending a request to receiving its
+// hull.
+//
+//   HullLoadGenerator [--server NAME] [--connections N] [--depth N]
+//                     [--requests N] [--points N] [--distribution NAME]
+//                     [--algorithm INDEX]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int ConnectTimeoutMs = 5000;
+constexpr int ResponseTimeoutMs = 30000;
+// Distinct point sets per connection; requests cycle through them.
+constexpr int DatasetCount = 16;
+
+struct Options
+{
+    std::string server = "convex-hull";
+    int connections = 4;
+    int depth = 16;
+    int requests = 2000;
+    int points = 1000;
+    PointGenerator::Distribution distribution = PointGenerator::Distribution::Uniform;
+    std::uint32_t algorithm = 0;
+};
+
+struct ConnectionResult
+{
+    bool connected = false;
+    int completed = 0;
+    int errors = 0;
+    std::vector<double> latenciesUs;
+};
+
+bool parseArguments(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--server") == 0 && i + 1 < argc) {
+            options.server = argv[++i];
+        } else if (std::strcmp(argv[i], "--connections") == 0 && i + 1 < argc) {
+            options.connections = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--depth") == 0 && i + 1 < argc) {
+            options.depth = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--requests") == 0 && i + 1 < argc) {
+            options.requests = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--points") == 0 && i + 1 < argc) {
+            options.points = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--algorithm") == 0 && i + 1 < argc) {
+            options.algorithm = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--distribution") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            bool found = false;
+            for (PointGenerator::Distribution distribution : PointGenerator::distributions()) {
+                if (std::strcmp(PointGenerator::name(distribution), name) == 0) {
+                    options.distribution = distribution;
+                    found = true;
+                }
+            }
+            if (!found) {
+                std::fprintf(stderr, "unknown distribution %s\n", name);
+                return false;
+            }
+        } else {
+            std::fprintf(stderr,
+                         "usage: %s [--server NAME] [--connections N] [--depth N] [--requests N]\n"
+                         "       [--points N] [--distribution NAME] [--algorithm INDEX]\n",
+                         argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Request frames built once; only the id in the header changes per request.
+std::vector<std::vector<char>> buildFrames(const Options& options, int connection)
+{
+    std::vector<std::vector<char>> frames;
+    for (int i = 0; i < DatasetCount; ++i) {
+        PointGenerator::Options generatorOptions;
+        generatorOptions.distribution = options.distribution;
+        generatorOptions.seed = static_cast<std::uint64_t>(connection) * DatasetCount + i;
+        generatorOptions.maxX = 1920;
+        generatorOptions.maxY = 1080;
+        generatorOptions.integral = true;
+        const std::vector<Point> points = PointGenerator::generate(generatorOptions, options.points);
+
+        HullProtocol::FrameHeader header;
+        header.magic = HullProtocol::RequestMagic;
+        header.requestId = 0;
+        header.code = options.algorithm;
+        header.count = static_cast<std::uint32_t>(points.size());
+
+        std::vector<char> frame(sizeof(header) + HullProtocol::payloadBytes(header.count));
+        std::memcpy(frame.data(), &header, sizeof(header));
+        std::memcpy(frame.data() + sizeof(header), points.data(), HullProtocol::payloadBytes(header.count));
+        frames.push_back(std::move(frame));
+    }
+    return frames;
+}
+
+void runConnection(const Options& options, int connection, ConnectionResult& result)
+{
+    const std::vector<std::vector<char>> frames = buildFrames(options, connection);
+
+    QLocalSocket socket;
+    socket.connectToServer(QString::fromStdString(options.server));
+    if (!socket.waitForConnected(ConnectTimeoutMs)) {
+        return;
+    }
+    result.connected = true;
+    result.latenciesUs.reserve(options.requests);
+
+    std::vector<Clock::time_point> sentAt(options.requests);
+    std::vector<Point> hull;
+    int sent = 0;
+
+    while (result.completed < options.requests) {
+        while (sent < options.requests && sent - result.completed < options.depth) {
+            const std::vector<char>& frame = frames[sent % frames.size()];
+            HullProtocol::FrameHeader header;
+            std::memcpy(&header, frame.data(), sizeof(header));
+            header.requestId = static_cast<std::uint32_t>(sent);
+
+            sentAt[sent] = Clock::now();
+            socket.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            socket.write(frame.data() + sizeof(header), static_cast<qint64>(frame.size() - sizeof(header)));
+            ++sent;
+        }
+        socket.flush();
+
+        HullProtocol::FrameHeader header;
+        while (socket.bytesAvailable() < qint64(sizeof(header)) ||
+               socket.peek(reinterpret_cast<char*>(&header), sizeof(header)) < qint64(sizeof(header)) ||
+               socket.bytesAvailable() < qint64(sizeof(header) + HullProtocol::payloadBytes(header.count)))
+        {
+            if (!socket.waitForReadyRead(ResponseTimeoutMs)) {
+                result.errors += options.requests - result.completed;
+                return;
+            }
+        }
+
+        socket.read(reinterpret_cast<char*>(&header), sizeof(header));
+        hull.resize(header.count);
+        socket.read(reinterpret_cast<char*>(hull.data()), HullProtocol::payloadBytes(header.count));
+
+        if (header.magic != HullProtocol::ResponseMagic || header.requestId >= static_cast<std::uint32_t>(sent)) {
+            result.errors += options.requests - result.completed;
+            return;
+        }
+        if (header.code != HullProtocol::Ok || hull.empty()) {
+            ++result.errors;
+        }
+
+        const auto latency = Clock::now() - sentAt[header.requestId];
+        result.latenciesUs.push_back(std::chrono::duration<double, std::micro>(latency).count());
+        ++result.completed;
+    }
+}
+
+double percentile(const std::vector<double>& sorted, double fraction)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const std::size_t index = static_cast<std::size_t>(std::ceil(fraction * sorted.size()));
+    return sorted[std::min(sorted.size(), std::max<std::size_t>(index, 1)) - 1];
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    QCoreApplication application(argc, argv);
+
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        return 2;
+    }
+
+    std::vector<ConnectionResult> results(options.connections);
+    std::vector<std::thread> threads;
+
+    const Clock::time_point start = Clock::now();
+    for (int i = 0; i < options.connections; ++i) {
+        threads.emplace_back([&options, &results, i]() {
+            runConnection(options, i, results[i]);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<double> latencies;
+    int completed = 0;
+    int errors = 0;
+    for (const ConnectionResult& result : results) {
+        if (!result.connected) {
+            std::fprintf(stderr, "could not connect to %s\n", options.server.c_str());
+            return 1;
+        }
+        latencies.insert(latencies.end(), result.latenciesUs.begin(), result.latenciesUs.end());
+        completed += result.completed;
+        errors += result.errors;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    std::printf("%d connection(s), depth %d, %d points per request (%s)\n",
+                options.connections, options.depth, options.points, PointGenerator::name(options.distribution));
+    std::printf("%d request(s) in %.3f s: %.0f requests/s, %d error(s)\n",
+                completed, seconds, completed / seconds, errors);
+    std::printf("latency us  p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f\n",
+                percentile(latencies, 0.50), percentile(latencies, 0.90), percentile(latencies, 0.99),
+                percentile(latencies, 0.999), latencies.empty() ? 0.0 : latencies.back());
+
+    return errors == 0 ? 0 : 1;
+}